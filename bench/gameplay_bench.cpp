@@ -0,0 +1,595 @@
+// Native microbenchmarks for the gameplay hot paths.
+//
+// Usage: gameplay_bench [filter]
+//   Runs every benchmark whose name contains `filter` and prints ns/op and
+//   heap allocations per op. Everything except the Map::draw benchmark runs
+//   without a window; that one needs a display (xvfb-run works, with Mesa's
+//   software GL) and is skipped otherwise. The bridge load section plays
+//   simulated minutes of automatic fire against the mock chain and reports
+//   the transaction flow instead of ns/op.
+
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "map.h"
+#include "player.h"
+#include "sound_bank.h"
+#include "asset_loader.h"
+#include "effects.h"
+#include "hitboxes.h"
+#include "projectiles.h"
+#include "job_system.h"
+#include "alloc_tracker.h"
+#include "action_queue.h"
+#include "movement_sync.h"
+#include "native_bridge.h"
+#include "mock_chain.h"
+#include "bolt_components.h"
+#include "account_mirror.h"
+#include "tx_templates.h"
+#include "bridge_events.h"
+#include "bridge_latency.h"
+
+#ifndef ASSETS_ROOT
+#define ASSETS_ROOT "."
+#endif
+
+// Keeps the optimizer from discarding benchmark results
+static volatile float benchSink = 0.0f;
+
+static const char* benchFilter = nullptr;
+
+// Runs `body(iterations)` with a growing iteration count until a batch takes
+// at least 200ms, then reports the per-op cost of that batch.
+template <typename Body>
+static void runBenchmark(const char* name, Body body) {
+    if (benchFilter && !strstr(name, benchFilter)) return;
+
+    using Clock = std::chrono::steady_clock;
+    long iterations = 1;
+    double elapsedNs = 0.0;
+    size_t allocs = 0;
+
+    body(1); // Warm up caches and lazily-grown containers
+
+    while (true) {
+        size_t allocsBefore = AllocTracker::totalAllocations();
+        Clock::time_point start = Clock::now();
+        body(iterations);
+        Clock::time_point end = Clock::now();
+        allocs = AllocTracker::totalAllocations() - allocsBefore;
+        elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        if (elapsedNs >= 2.0e8 || iterations >= (1L << 30)) break;
+
+        // Aim past the target directly instead of doubling from 1
+        double scale = elapsedNs > 0.0 ? 2.5e8 / elapsedNs : 100.0;
+        if (scale > 100.0) scale = 100.0;
+        if (scale < 2.0) scale = 2.0;
+        iterations = (long)(iterations * scale);
+    }
+
+    printf("%-44s %12ld %14.1f ns/op %10.3f allocs/op\n",
+           name, iterations, elapsedNs / iterations, (double)allocs / iterations);
+}
+
+// Tiles the stock arena `tiles` times on a square grid, giving a map with
+// `tiles` times as many walls and platforms at the same density.
+static void buildScaledArena(Map& map, int tiles) {
+    map.loadCyberpunkArena();
+    if (tiles <= 1) return;
+
+    const float tileSize = 100.0f;
+    int side = (int)ceilf(sqrtf((float)tiles));
+    std::vector<Wall> baseWalls = map.walls;
+    std::vector<Platform> basePlatforms = map.platforms;
+
+    map.walls.clear();
+    map.platforms.clear();
+    for (int t = 0; t < tiles; t++) {
+        Vector3 offset = { (t % side - (side - 1) * 0.5f) * tileSize, 0.0f, (t / side - (side - 1) * 0.5f) * tileSize };
+        for (Wall wall : baseWalls) {
+            wall.position = Vector3Add(wall.position, offset);
+            map.walls.push_back(wall);
+        }
+        for (Platform platform : basePlatforms) {
+            platform.position = Vector3Add(platform.position, offset);
+            map.platforms.push_back(platform);
+        }
+    }
+    map.groundSize = (Vector2){ side * tileSize, side * tileSize };
+}
+
+// Deterministic sample points spread over the map's ground plane
+static std::vector<Vector3> samplePositions(const Map& map, int count) {
+    std::vector<Vector3> points;
+    points.reserve(count);
+    SetRandomSeed(1234);
+    float halfX = map.groundSize.x * 0.5f;
+    float halfZ = map.groundSize.y * 0.5f;
+    for (int i = 0; i < count; i++) {
+        points.push_back((Vector3){
+            GetRandomValue(-1000, 1000) / 1000.0f * halfX,
+            GetRandomValue(10, 60) / 10.0f,
+            GetRandomValue(-1000, 1000) / 1000.0f * halfZ
+        });
+    }
+    return points;
+}
+
+static void benchCollision(const char* name, int tiles) {
+    Map map;
+    buildScaledArena(map, tiles);
+    std::vector<Vector3> points = samplePositions(map, 1024);
+
+    runBenchmark(name, [&](long iterations) {
+        Vector3 correction;
+        for (long i = 0; i < iterations; i++) {
+            if (map.checkCollision(points[i & 1023], 0.4f, correction)) benchSink += correction.x;
+        }
+    });
+}
+
+static void benchRaycast(const char* name, int tiles) {
+    Map map;
+    buildScaledArena(map, tiles);
+    std::vector<Vector3> points = samplePositions(map, 1024);
+    std::vector<Vector3> directions;
+    directions.reserve(1024);
+    for (int i = 0; i < 1024; i++) {
+        float yaw = GetRandomValue(0, 6283) / 1000.0f;
+        float pitch = GetRandomValue(-300, 300) / 1000.0f;
+        directions.push_back(Vector3Normalize((Vector3){ cosf(yaw) * cosf(pitch), sinf(pitch), sinf(yaw) * cosf(pitch) }));
+    }
+
+    runBenchmark(name, [&](long iterations) {
+        Vector3 hitPoint;
+        for (long i = 0; i < iterations; i++) {
+            Ray ray = { points[i & 1023], directions[i & 1023] };
+            if (map.raycastWalls(ray, 300.0f, hitPoint)) benchSink += hitPoint.x;
+        }
+    });
+}
+
+// `players` standing around the stock arena, every one shooting at a
+// random other one; an op is one shot checked against all of them
+static void benchHitboxes(const char* name, int players, bool batched) {
+    Map map;
+    map.loadCyberpunkArena();
+    Hitboxes hitboxes;
+    std::vector<Vector3> eyes;
+    SetRandomSeed(4321);
+    for (int i = 0; i < players; i++) {
+        Vector3 eye = { GetRandomValue(-450, 450) / 10.0f, 1.8f, GetRandomValue(-450, 450) / 10.0f };
+        eyes.push_back(eye);
+        hitboxes.add(eye, GetRandomValue(0, 6283) / 1000.0f, i);
+    }
+    std::vector<Ray> rays;
+    for (int i = 0; i < 1024; i++) {
+        Vector3 from = eyes[i % players];
+        Vector3 to = eyes[(i + 1 + GetRandomValue(0, players - 2)) % players];
+        to.y -= GetRandomValue(0, 150) / 100.0f;
+        rays.push_back((Ray){ from, Vector3Normalize(Vector3Subtract(to, from)) });
+        rays.back().position = Vector3Add(from, Vector3Scale(rays.back().direction, 1.1f)); // Out of the shooter's own box
+    }
+    std::vector<ShotHit> hits(rays.size());
+
+    runBenchmark(name, [&](long iterations) {
+        if (batched) {
+            for (long done = 0; done < iterations; done += 1024) {
+                int count = iterations - done < 1024 ? (int)(iterations - done) : 1024;
+                hitboxes.raycastBatch(rays.data(), count, 300.0f, &map, hits.data());
+                benchSink += hits[0].distance;
+            }
+        } else {
+            for (long i = 0; i < iterations; i++) {
+                ShotHit hit = hitboxes.raycast(rays[i & 1023], 300.0f, &map);
+                benchSink += hit.distance;
+            }
+        }
+    });
+}
+
+// `count` projectiles in flight over the (scaled) arena, past 16 players;
+// each one that lands is fired again, so the load stays constant. An op is
+// one step of all of them.
+static void benchProjectiles(const char* name, int count, int tiles) {
+    Map map;
+    buildScaledArena(map, tiles);
+    CollisionGrid grid;
+    grid.build(map);
+    Hitboxes targets;
+    std::vector<Vector3> points = samplePositions(map, 1024);
+    for (int i = 0; i < 16; i++) {
+        targets.add((Vector3){ points[i].x, 1.8f, points[i].z }, 0.0f, i);
+    }
+    static Projectiles projectiles;     // Too big for the stack
+    projectiles.clear();
+    int next = 0;
+    auto refill = [&]() {
+        while (projectiles.count() < count) {
+            float yaw = (float)(next & 1023) * 0.006f;
+            Vector3 velocity = { cosf(yaw) * 60.0f, 4.0f, sinf(yaw) * 60.0f };
+            projectiles.spawn(points[next & 1023], velocity, 9.8f, 2);
+            next++;
+        }
+    };
+
+    runBenchmark(name, [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            refill();
+            projectiles.step(1.0f / 60.0f, grid, &targets);
+            benchSink += (float)projectiles.hitCount();
+        }
+    });
+}
+
+static void benchParticles(const char* name, int particleCount) {
+    Effects effects(Effects::DEFAULT_MAX_TRACERS, particleCount);
+    SetRandomSeed(42);
+    while ((int)effects.impactParticles.size() < particleCount) {
+        effects.spawnImpact((Vector3){ 0.0f, 2.0f, 0.0f });
+    }
+    // Effectively immortal, so the working set stays constant across batches
+    for (auto& p : effects.impactParticles) p.lifetime = p.maxLifetime = 1.0e6f;
+
+    // One op is a full update of `particleCount` live particles
+    runBenchmark(name, [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            effects.update(1.0f / 60.0f);
+        }
+        benchSink += effects.impactParticles[0].position.y;
+    });
+}
+
+static void benchPlayerBasis() {
+    Player player;
+    AssetLoader::instance().finish();
+    SoundBank::instance().update();
+
+    runBenchmark("Player::getForward", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            player.yaw = (float)(i & 1023) * 0.006f;
+            Vector3 forward = player.getForward();
+            benchSink += forward.x;
+        }
+    });
+
+    runBenchmark("Player::getRight", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            player.yaw = (float)(i & 1023) * 0.006f;
+            Vector3 right = player.getRight();
+            benchSink += right.x;
+        }
+    });
+
+    // `player` keeps the footsteps loaded, so another Player only takes references
+    runBenchmark("Player::Player/shared sounds", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            Player other;
+            benchSink += other.yaw;
+        }
+    });
+}
+
+static void benchMapDraw(const char* name, int tiles) {
+    Map map;
+    buildScaledArena(map, tiles);
+    Camera3D camera = { 0 };
+    camera.position = (Vector3){ 0.0f, 2.0f, 5.0f };
+    camera.target = (Vector3){ 0.0f, 2.0f, 0.0f };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 70.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    // One op is one full map submission, flushed to the driver
+    runBenchmark(name, [&](long iterations) {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        BeginMode3D(camera);
+        for (long i = 0; i < iterations; i++) {
+            map.draw();
+            rlDrawRenderBatchActive();
+        }
+        EndMode3D();
+        EndDrawing();
+    });
+}
+
+// Account decoding: binding a zero-copy view (discriminator + bounds check,
+// then loads at fixed offsets) against building the owning struct
+static void benchAccountDecode() {
+    uint8_t healthBytes[256];
+    bolt::Health health = {};
+    health.maxHp = 100;
+    health.currentHp = 75;
+    health.isAlive = true;
+    health.respawnTimestamp = 1700000000;
+    borsh::Writer healthWriter(healthBytes, sizeof(healthBytes));
+    bolt::encodeAccount(healthWriter, health);
+
+    uint8_t positionBytes[256];
+    bolt::Position position = {};
+    position.x = 12.5;
+    position.velocityX = 3.0f;
+    borsh::Writer positionWriter(positionBytes, sizeof(positionBytes));
+    bolt::encodeAccount(positionWriter, position);
+
+    uint8_t playerBytes[256];
+    bolt::Player player = {};
+    player.username = "benchmark-player";
+    player.hasLoggedIn = true;
+    player.level = 7;
+    borsh::Writer playerWriter(playerBytes, sizeof(playerBytes));
+    bolt::encodeAccount(playerWriter, player);
+
+    runBenchmark("Account/PositionView bind+read", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            bolt::PositionView view;
+            if (bolt::PositionView::bind(positionBytes, positionWriter.size(), view)) {
+                benchSink += (float)view.x() + view.velocityX();
+            }
+        }
+    });
+
+    runBenchmark("Account/HealthView bind+read", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            bolt::HealthView view;
+            if (bolt::HealthView::bind(healthBytes, healthWriter.size(), view)) {
+                benchSink += (float)view.currentHp() + (view.respawnTimestamp() ? 1.0f : 0.0f);
+            }
+        }
+    });
+
+    runBenchmark("Account/PlayerView bind+read", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            bolt::PlayerView view;
+            if (bolt::PlayerView::bind(playerBytes, playerWriter.size(), view)) {
+                benchSink += (float)view.level() + (float)view.username().size();
+            }
+        }
+    });
+
+    runBenchmark("Account/Player decode()", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            bolt::PlayerView view;
+            if (bolt::PlayerView::bind(playerBytes, playerWriter.size(), view)) {
+                bolt::Player decoded = view.decode();
+                benchSink += (float)decoded.level + (float)decoded.username.size();
+            }
+        }
+    });
+}
+
+// Subscription traffic: 16 players' Position accounts updated round-robin,
+// with a dispatch per frame's worth of updates
+static void benchAccountMirror() {
+    uint8_t positionBytes[256];
+    bolt::Position position = {};
+    borsh::Writer writer(positionBytes, sizeof(positionBytes));
+    bolt::encodeAccount(writer, position);
+
+    char addresses[16][48];
+    for (int i = 0; i < 16; i++) snprintf(addresses[i], sizeof(addresses[i]), "bench-entity-%d/position", i);
+
+    AccountMirror& mirror = AccountMirror::instance();
+    mirror.clear();
+    uint64_t slot = 1;
+    runBenchmark("AccountMirror::apply+dispatch", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            mirror.apply(addresses[i & 15], nullptr, slot++, positionBytes, writer.size());
+            if ((i & 15) == 15) mirror.dispatch();
+        }
+    });
+    runBenchmark("AccountMirror::apply/stale", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            benchSink += mirror.apply(addresses[i & 15], nullptr, 1, positionBytes, writer.size()) ? 1.0f : 0.0f;
+        }
+    });
+    mirror.clear();
+}
+
+// Message bytes for the gameplay instructions with dummy session keys: a
+// patched single-instruction template, a 4-action batch laid out from the
+// prepared parts, and preparing every template from scratch
+static void benchTxTemplates() {
+    TxTemplates& templates = TxTemplates::instance();
+    for (int account = 0; account < TX_ACCOUNT_VICTIM; account++) {
+        uint8_t key[TxTemplates::KEY_SIZE];
+        memset(key, 0x10 + account, sizeof(key));
+        templates.setAccountKey((TxAccount)account, key);
+    }
+    uint8_t blockhash[TxTemplates::KEY_SIZE];
+    memset(blockhash, 0xAB, sizeof(blockhash));
+    templates.setBlockhashKey(blockhash);
+    templates.prepare();
+
+    BatchAction actions[4];
+    memset(actions, 0, sizeof(actions));
+    actions[0].type = BATCH_ACTION_SHOOT;
+    actions[0].weaponSlot = 1;
+    actions[1].type = BATCH_ACTION_MOVEMENT;
+    actions[2].type = BATCH_ACTION_SHOOT;
+    actions[2].weaponSlot = 1;
+    actions[3].type = BATCH_ACTION_RELOAD;
+    actions[3].weaponSlot = 1;
+
+    uint32_t size = 0;
+    runBenchmark("TxTemplates::build/shoot", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            actions[0].weaponSlot = (uint8_t)(1 + (i & 1));
+            benchSink += templates.build(actions, 1, &size) ? (float)size : 0.0f;
+        }
+    });
+    runBenchmark("TxTemplates::build/batch of 4", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            benchSink += templates.build(actions, 4, &size) ? (float)size : 0.0f;
+        }
+    });
+    runBenchmark("TxTemplates::prepare", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            benchSink += templates.prepare() ? 1.0f : 0.0f;
+        }
+    });
+    templates.reset();
+}
+
+// Recording one bridge sample (every helper callback pays this) and reading
+// p99 back, as the F4 overlay does for each instruction every frame
+static void benchBridgeLatency() {
+    LatencyHistogram histogram;
+    histogram.reset();
+    runBenchmark("LatencyHistogram::record", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            histogram.record(200000 + (uint64_t)((i * 7919) % 600000));
+        }
+    });
+    runBenchmark("LatencyHistogram::percentile", [&](long iterations) {
+        for (long i = 0; i < iterations; i++) {
+            benchSink += (float)histogram.percentile(99.0);
+        }
+    });
+}
+
+// Simulated player holding the trigger at 600 RPM while strafing in a circle,
+// at 60 fps against the mock chain. Mock time is stepped, so a minute of
+// play takes milliseconds; the wall-clock cost is the client's side of it.
+static void benchBridgeLoad(const char* name, double latencyMs, double jitterMs, double failureRate) {
+    if (benchFilter && !strstr(name, benchFilter)) return;
+
+    MockChainConfig config = MockChainConfig::defaults();
+    config.latencyMs = latencyMs;
+    config.jitterMs = jitterMs;
+    config.failureRate = failureRate;
+    MockChain& chain = MockChain::instance();
+    chain.configure(config);
+
+    ActionQueue& queue = ActionQueue::instance();
+    queue.setEnabled(false);
+    queue.setEnabled(true);
+    ActionQueueStats before = queue.stats();
+    MovementSync sync;
+
+    const double duration = 60.0;
+    const float dt = 1.0f / 60.0f;
+    int ammo = 30;
+    float cooldown = 0.0f;
+    int maxInFlight = 0;
+    int maxDepth = 0;
+    double time = chain.now();
+    double end = time + duration;
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    long frames = 0;
+    for (; time < end; time += dt, frames++) {
+        float angle = (float)(time * 0.5);
+        Vector3 position = { 10.0f * cosf(angle), 1.8f, 10.0f * sinf(angle) };
+        Vector3 velocity = { -5.0f * sinf(angle), 0.0f, 5.0f * cosf(angle) };
+
+        cooldown -= dt;
+        if (cooldown <= 0.0f) {
+            if (ammo == 0) {
+                queue.enqueueReload(1);
+                ammo = 30;
+            }
+            queue.enqueueShoot(1);
+            ammo--;
+            cooldown += 0.1f;
+        }
+
+        chain.poll(time);
+        BridgeEvents::instance().dispatch();
+        sync.update(dt, position, angle, velocity, MOVE_FORWARD | MOVE_RIGHT);
+        queue.pump();
+
+        ActionQueueStats stats = queue.stats();
+        if (stats.inFlight > maxInFlight) maxInFlight = stats.inFlight;
+        if (stats.depth > maxDepth) maxDepth = stats.depth;
+    }
+    double elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+    // Let the last transactions land so the counts add up
+    for (int i = 0; i < 600 && queue.stats().inFlight > 0; i++) {
+        time += dt;
+        chain.poll(time);
+        BridgeEvents::instance().dispatch();
+        queue.pump();
+    }
+
+    ActionQueueStats after = queue.stats();
+    printf("%-44s %5.0f s  %6u tx (%5.1f/s)  ok %6u  failed %5u  coalesced %6u  dropped %6u  in-flight max %d  depth max %2d  %8.1f ns/frame\n",
+           name, duration, after.sent - before.sent, (after.sent - before.sent) / duration,
+           after.succeeded - before.succeeded, after.failed - before.failed,
+           after.coalesced - before.coalesced, after.dropped - before.dropped,
+           maxInFlight, maxDepth, elapsedNs / frames);
+
+    queue.setEnabled(false);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) benchFilter = argv[1];
+
+    SetTraceLogLevel(LOG_WARNING);
+    ChangeDirectory(ASSETS_ROOT);
+    JobSystem::instance().start(); // Effects::update runs on it, as in the game
+
+    printf("%-44s %12s %20s %20s\n", "benchmark", "iterations", "time", "allocations");
+
+    benchCollision("Map::checkCollision/stock", 1);
+    benchCollision("Map::checkCollision/10x", 10);
+    benchCollision("Map::checkCollision/100x", 100);
+
+    benchRaycast("Map::raycastWalls/stock", 1);
+    benchRaycast("Map::raycastWalls/10x", 10);
+    benchRaycast("Map::raycastWalls/100x", 100);
+
+    benchHitboxes("Hitboxes::raycast/16 players", 16, false);
+    benchHitboxes("Hitboxes::raycast/64 players", 64, false);
+    benchHitboxes("Hitboxes::raycastBatch/64 players", 64, true);
+
+    benchProjectiles("Projectiles::step/1k in flight", 1000, 1);
+    benchProjectiles("Projectiles::step/4k in flight", 4000, 1);
+    benchProjectiles("Projectiles::step/4k in flight, 100x", 4000, 100);
+    
+    benchParticles("Effects::update/1k particles", 1000);
+    benchParticles("Effects::update/10k particles", 10000);
+
+    benchAccountDecode();
+    benchAccountMirror();
+    benchTxTemplates();
+    benchBridgeLatency();
+
+    NativeBridgeSetEnabled(true);
+    benchBridgeLoad("BridgeLoad/400ms", 400.0, 150.0, 0.0);
+    benchBridgeLoad("BridgeLoad/1500ms", 1500.0, 500.0, 0.0);
+    benchBridgeLoad("BridgeLoad/400ms 5% failures", 400.0, 150.0, 0.05);
+    NativeBridgeSetEnabled(false);
+
+    // Player loads its footstep sounds; the null audio backend is enough
+    InitAudioDevice();
+    benchPlayerBasis();
+    CloseAudioDevice();
+
+    // Rendering needs a GL context, which needs a display
+    if (getenv("DISPLAY") || getenv("WAYLAND_DISPLAY")) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(1280, 720, "gameplay_bench");
+        if (IsWindowReady()) {
+            SetTargetFPS(0);
+            benchMapDraw("Map::draw/stock", 1);
+            benchMapDraw("Map::draw/10x", 10);
+            CloseWindow();
+        }
+    } else {
+        printf("%-44s skipped (no display; run under xvfb-run)\n", "Map::draw");
+    }
+
+    return 0;
+}
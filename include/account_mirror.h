@@ -0,0 +1,109 @@
+#ifndef ACCOUNT_MIRROR_H
+#define ACCOUNT_MIRROR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bolt_components.h"
+
+enum AccountKind : uint8_t {
+    ACCOUNT_UNKNOWN = 0,
+    ACCOUNT_POSITION,
+    ACCOUNT_HEALTH,
+    ACCOUNT_WEAPON,
+    ACCOUNT_PLAYER,
+    ACCOUNT_PLAYER_STATS,
+    ACCOUNT_GAME,
+    ACCOUNT_KIND_COUNT
+};
+
+// Latest known bytes of one on-chain account
+struct AccountRecord {
+    static const int ADDRESS_SIZE = 48;
+    static const int MAX_DATA_SIZE = 512;
+
+    char address[ADDRESS_SIZE];   // Account pubkey (base58)
+    char entity[ADDRESS_SIZE];    // Bolt entity the component belongs to, if known
+    AccountKind kind;
+    uint64_t slot;                // Slot of the update these bytes came from
+    uint32_t size;
+    bool notifyPending;
+    uint8_t data[MAX_DATA_SIZE];
+
+    // Zero-copy typed access, e.g. record.view(positionView)
+    template <typename View>
+    bool view(View& out) const { return View::bind(data, size, out); }
+};
+
+struct AccountMirrorStats {
+    uint32_t applied;
+    uint32_t stale;       // Older slot than what we have
+    uint32_t duplicate;   // Same slot again (feeds redeliver)
+    uint32_t rejected;    // Too large, or the mirror is full
+};
+
+typedef void (*AccountListener)(const AccountRecord& record, void* user);
+
+// Local copy of the accounts the game cares about, kept current by
+// subscription updates instead of per-frame fetches. Updates carry the slot
+// they were observed at; anything older than the stored copy is ignored, so
+// out-of-order delivery can't roll state back. Listeners hear about changed
+// accounts once per frame, from dispatch(), on the main thread.
+//
+// Feeds: on web, SolanaGameBridge.subscribeAccounts pushes raw account data
+// in; natively, the mock chain publishes its component state.
+class AccountMirror {
+public:
+    static const int MAX_ACCOUNTS = 128;
+    static const int MAX_LISTENERS = 16;
+
+    static AccountMirror& instance();
+
+    // Start receiving updates from whichever feed this build has
+    void connectFeed();
+
+    // Store an update. `entity` may be null. Returns true if it changed the mirror.
+    bool apply(const char* address, const char* entity, uint64_t slot, const uint8_t* data, size_t size);
+
+    const AccountRecord* find(const char* address) const;
+    const AccountRecord* findComponent(const char* entity, AccountKind kind) const;   // Linear scan
+    int count() const { return records; }
+    const AccountRecord& record(int index) const { return accounts[index]; }
+
+    // The local player's entity, so systems can tell "us" from remote players
+    void setLocalEntity(const char* entity);
+    bool isLocalEntity(const char* entity) const;
+
+    // `kind` ACCOUNT_UNKNOWN listens to every kind. Returns false if full.
+    bool subscribe(AccountKind kind, AccountListener listener, void* user);
+    void unsubscribe(AccountListener listener, void* user);
+
+    // Notify listeners of everything that changed since the last call
+    void dispatch();
+
+    void clear();
+    const AccountMirrorStats& stats() const { return totals; }
+
+    static AccountKind kindOf(const uint8_t* data, size_t size);
+
+private:
+    struct Listener {
+        AccountKind kind;
+        AccountListener callback;
+        void* user;
+    };
+
+    AccountMirror();
+    int slotFor(const char* address) const;
+
+    AccountRecord accounts[MAX_ACCOUNTS];
+    int records;
+    int16_t index[MAX_ACCOUNTS * 2];   // Open-addressed hash of address -> record
+    int changed[MAX_ACCOUNTS];
+    int changedCount;
+    Listener listeners[MAX_LISTENERS];
+    int listenerCount;
+    char localEntity[AccountRecord::ADDRESS_SIZE];
+    AccountMirrorStats totals;
+};
+
+#endif // ACCOUNT_MIRROR_H
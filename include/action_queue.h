@@ -0,0 +1,133 @@
+#ifndef ACTION_QUEUE_H
+#define ACTION_QUEUE_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "execute_batch.h"
+
+// Counters for the debug overlay; totals are since startup
+struct ActionQueueStats {
+    int depth;          // Actions waiting to be sent
+    int inFlight;       // Transactions sent and not yet answered
+    uint32_t enqueued;
+    uint32_t coalesced; // Merged into an action that was already waiting
+    uint32_t dropped;   // Rejected because the queue was full
+    uint32_t sent;      // Transactions submitted; a batch counts once
+    uint32_t succeeded;
+    uint32_t failed;
+    uint32_t timedOut;  // Failed here after TIMEOUT_MS without an answer; counted in failed too
+};
+
+// Identifies a queued action; 0 means it was dropped (or the queue is off)
+typedef uint32_t ActionId;
+
+// Outcome of one action. Actions sent in the same batch share its result;
+// actions discarded before sending fail with "Cancelled".
+typedef void (*ActionResultListener)(ActionId id, uint8_t type, bool success, const char* error, void* user);
+
+// Sits in front of the contract helpers (Shoot, Reload, UpdateMovement, ...)
+// so gameplay code can fire actions at any rate without flooding the chain.
+// - State updates (movement, weapon switch) replace the one already waiting
+//   and duplicate reloads are merged (not across a shot from that slot).
+// - Waiting actions go out in batches of up to MAX_BATCH, one transaction each.
+// - At most maxInFlight transactions are outstanding; the rest wait here, and
+//   once the queue is full new actions are dropped and counted. Shots and
+//   damage stop STATE_RESERVE slots short of full.
+// - Every action gets an id, and result listeners hear how it ended, so
+//   gameplay can predict locally and roll back what the chain rejects.
+// - A transaction unanswered after TIMEOUT_MS fails as "Transaction timed
+//   out" and frees its in-flight place; an answer that turns up later is
+//   ignored. Its callback slot is only reused after that answer, so once
+//   SLOTS answers are owed nothing more is sent.
+// Fixed storage, so enqueueing never allocates.
+class ActionQueue {
+public:
+    static const int CAPACITY = 32;
+    static const int MAX_BATCH = 4;          // Keeps a batch well inside the transaction size limit
+    static const int STATE_RESERVE = 4;      // Slots only state updates may use, so a held trigger can't starve them
+    static const int DEFAULT_MAX_IN_FLIGHT = 2;
+    static const int MAX_IN_FLIGHT = 8;
+    static const int SLOTS = 2 * MAX_IN_FLIGHT;   // Timed-out slots stay reserved for their late answer
+    static constexpr double TIMEOUT_MS = 30000.0;
+    static const int MAX_LISTENERS = 4;
+    static const int VICTIM_ADDRESS_SIZE = 48;
+    static const int ERROR_SIZE = 128;
+
+    static ActionQueue& instance();
+
+    // Enqueue calls are ignored while disabled (e.g. no wallet connected);
+    // disabling also discards anything still waiting
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+    void setMaxInFlight(int limit);   // Clamped to 1..MAX_IN_FLIGHT
+
+    // Each returns 0 if the action was dropped. An action merged into one
+    // that was already waiting returns the waiting action's id.
+    ActionId enqueueMovement(Vector3 position, float rotation, Vector3 velocity);
+    ActionId enqueueShoot(uint8_t weaponSlot);
+    ActionId enqueueReload(uint8_t weaponSlot);
+    ActionId enqueueSwitchWeapon(uint8_t weaponSlot);
+    ActionId enqueueApplyDamage(const char* victimAddress, uint8_t weaponType, bool isHeadshot, float distance);
+
+    bool addResultListener(ActionResultListener listener, void* user);
+    void removeResultListener(ActionResultListener listener, void* user);
+
+    // Fails transactions past their deadline, then sends as much as the
+    // in-flight cap allows. Call once per frame.
+    void pump();
+    // pump() with the clock (BridgeLatency::now() milliseconds) given, for tests
+    void pump(double now);
+    void clear();
+
+    ActionQueueStats stats() const;
+    const char* lastError() const { return lastErrorText; }
+
+private:
+    struct QueuedAction {
+        BatchAction action;
+        ActionId id;
+        char victimAddress[VICTIM_ADDRESS_SIZE];
+    };
+
+    // Actions of one transaction awaiting its callback
+    struct Transaction {
+        bool active;
+        bool expired;       // Timed out; its callback may still arrive
+        double sentAt;      // BridgeLatency::now()
+        int count;
+        ActionId ids[MAX_BATCH];
+        uint8_t types[MAX_BATCH];
+    };
+
+    struct Listener {
+        ActionResultListener callback;
+        void* user;
+    };
+
+    ActionQueue();
+    QueuedAction* findWaiting(uint8_t type, uint8_t weaponSlot, bool matchSlot);
+    ActionId push(const BatchAction& action, const char* victimAddress, bool isEvent);
+    void notify(ActionId id, uint8_t type, bool success, const char* error);
+    void complete(int transaction, bool success, const char* error);
+    void expire(double now);
+    int freeSlot() const;
+
+    // Bridge callbacks carry no context, so each transaction slot gets its own
+    template <int Slot>
+    static void onSent(bool success, const char* error);
+
+    QueuedAction ring[CAPACITY];
+    Transaction transactions[SLOTS];
+    Listener listeners[MAX_LISTENERS];
+    int listenerCount;
+    ActionId nextId;
+    int head;
+    int count;
+    int inFlight;
+    int maxInFlight;
+    bool enabled;
+    ActionQueueStats totals;
+    char lastErrorText[ERROR_SIZE];
+};
+
+#endif // ACTION_QUEUE_H
@@ -0,0 +1,47 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <stddef.h>
+
+// Subsystems that heap allocations are attributed to
+enum AllocSubsystem {
+    ALLOC_OTHER = 0,
+    ALLOC_PLAYER,
+    ALLOC_MAP,
+    ALLOC_EFFECTS,
+    ALLOC_UI,
+    ALLOC_BRIDGE,
+    ALLOC_RENDER,
+    ALLOC_SUBSYSTEM_COUNT
+};
+
+// Counts C++ heap allocations (global operator new) per frame and per
+// subsystem. Code tags itself with an AllocScope; anything untagged is
+// counted as ALLOC_OTHER. C allocations made inside raylib are not seen.
+// Replacing operator new is for measuring builds only: it is compiled in
+// with SOLFPS_ALLOC_TRACKING (CMake's ALLOC_TRACKING option, always on for
+// gameplay_bench). Otherwise the counts stay at zero.
+class AllocTracker {
+public:
+    static bool enabled();                                    // Whether this build counts anything
+    static void beginFrame();                                 // Reset the per-frame counters
+    static size_t frameAllocations();                         // All subsystems, this frame
+    static size_t frameAllocations(AllocSubsystem subsystem);
+    static size_t totalAllocations();                         // Since process start
+    static AllocSubsystem currentSubsystem();
+    static void setSubsystem(AllocSubsystem subsystem);       // Phase marker for sequential frame code
+    static const char* subsystemName(AllocSubsystem subsystem);
+    static void printFrameReport(const char* label);          // One line per subsystem that allocated
+};
+
+// Attributes allocations on this thread to a subsystem for the scope's lifetime
+class AllocScope {
+public:
+    explicit AllocScope(AllocSubsystem subsystem);
+    ~AllocScope();
+    
+private:
+    AllocSubsystem previous;
+};
+
+#endif // ALLOC_TRACKER_H
@@ -4,9 +4,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-#ifdef PLATFORM_WEB
-#include <emscripten.h>
-#endif
+#include "native_bridge.h"
+#include "bridge_mailbox.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,40 +25,16 @@ static inline void ApplyDamage(
     float distance,
     ApplyDamageCallback callback
 ) {
+    BridgeRequest request = { 0 };
+    request.instruction = BRIDGE_APPLY_DAMAGE;
+    request.address = victimAddress;
+    request.weaponSlot = weaponType;
+    request.isHeadshot = isHeadshot;
+    request.args[0] = distance;
 #ifdef PLATFORM_WEB
-    EM_ASM({
-        const victimAddr = UTF8ToString($0);
-        const weaponType = $1;
-        const isHeadshot = $2;
-        const distance = $3;
-        const callback = $4;
-        
-        if (!window.SolanaGameBridge) {
-            const errorMsg = "SolanaGameBridge not initialized";
-            const errorPtr = allocateUTF8(errorMsg);
-            Module.dynCall_vii(callback, 0, errorPtr);
-            _free(errorPtr);
-            return;
-        }
-        
-        window.SolanaGameBridge.applyDamage(
-            victimAddr,
-            weaponType,
-            isHeadshot,
-            distance
-        )
-            .then(() => {
-                Module.dynCall_vii(callback, 1, 0);
-            })
-            .catch(err => {
-                const errorMsg = err.message || "Apply damage failed";
-                const errorPtr = allocateUTF8(errorMsg);
-                Module.dynCall_vii(callback, 0, errorPtr);
-                _free(errorPtr);
-            });
-    }, victimAddress, weaponType, isHeadshot, distance, callback);
+    BridgeMailboxSubmit(&request, callback);
 #else
-    callback(false, "Web platform only");
+    NativeBridgeSubmit(&request, callback);
 #endif
 }
 
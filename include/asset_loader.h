@@ -0,0 +1,92 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// `work` runs on a loader thread (or, for submitMainThread() jobs, on the
+// main thread) and must not touch GL, audio device state or anything the
+// main thread is reading; `done` runs on the main thread,
+// from update(), and is where results are handed over (GPU uploads, audio
+// buffers, swapping into place). Either may be null.
+typedef void (*AssetWork)(void* user);
+typedef void (*AssetDone)(void* user);
+
+// Loads startup assets off the main thread so the window can draw a
+// progress screen right away. Jobs marked critical gate the start of play;
+// the rest finish while the game is already running.
+// Natively (and on web builds with pthreads) `work` runs on up to
+// MAX_WORKERS threads. Otherwise update() runs queued work itself, a
+// slice at a time, between progress frames.
+class AssetLoader {
+public:
+    static const int MAX_JOBS = 64;
+    static const int MAX_WORKERS = 4;
+    static const int NAME_SIZE = 48;
+    static constexpr double SLICE_SECONDS = 0.012;    // Inline work per update() without threads
+
+    static AssetLoader& instance();
+
+    // Spawns the workers; without it jobs run inline from update()
+    void start();
+    // Finishes every job, then joins the workers
+    void stop();
+
+    // False if MAX_JOBS are outstanding, in which case the job ran inline
+    bool submit(const char* name, bool critical, AssetWork work, AssetDone done, void* user);
+    // For work that has to run on the main thread, such as opening the audio
+    // device (a web worker has no AudioContext); update() runs it inline
+    bool submitMainThread(const char* name, bool critical, AssetWork work, AssetDone done, void* user);
+
+    // Main thread, once per frame: runs `done` for finished jobs (and, without
+    // workers, some queued work first). Returns how many completed.
+    int update();
+    // Blocks until every submitted job has completed
+    void finish();
+
+    bool criticalReady() const { return criticalDone == criticalTotal; }
+    bool idle() const { return outstanding == 0; }
+    float progress() const;             // Of the critical jobs, 0..1
+    const char* pending() const;        // Name of a critical job still running, or ""
+
+private:
+    enum JobState : uint8_t { JOB_FREE = 0, JOB_QUEUED, JOB_RUNNING, JOB_FINISHED };
+
+    struct Job {
+        JobState state;
+        bool critical;
+        bool mainThread;    // Run by update(), never by a worker
+        uint32_t order;     // Submission order; workers take the oldest
+        char name[NAME_SIZE];
+        AssetWork work;
+        AssetDone done;
+        void* user;
+    };
+
+    AssetLoader();
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    bool queue(const char* name, bool critical, bool mainThread, AssetWork work, AssetDone done, void* user);
+    int takeOldest(bool mainThread);    // Under the lock: marks it running
+    bool runOldest(bool mainThread);    // Takes one queued job of the kind and runs its work here
+    void workerLoop();
+    void complete(Job& job);
+
+    Job jobs[MAX_JOBS];
+    uint32_t submitted;
+    int outstanding;        // Submitted and not yet completed, main thread only
+    int criticalTotal;
+    int criticalDone;
+
+    mutable std::mutex lock;
+    std::condition_variable wake;
+    std::thread workers[MAX_WORKERS];
+    int workerCount;
+    bool stopping;
+};
+
+#endif // ASSET_LOADER_H
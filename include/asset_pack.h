@@ -0,0 +1,98 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <raylib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// One index entry as stored in the pack, 128 bytes, little endian.
+// Written by tools/pack_assets.py; keep the two in step.
+struct AssetPackEntry {
+    static const int NAME_SIZE = 96;
+
+    char name[NAME_SIZE];   // Path from the repo root, e.g. "assets/gun/audio/x.mp3"
+    uint8_t pack;           // Which pack file holds the payload; 0 = the main pack
+    uint8_t format;         // AssetPack::Format
+    uint8_t compression;    // AssetPack::Compression
+    uint8_t reserved;
+    uint32_t offset;        // Of the payload within its pack file
+    uint32_t storedSize;
+    uint32_t size;          // Once inflated
+    uint32_t sampleRate;    // FORMAT_PCM only
+    uint16_t sampleSize;
+    uint16_t channels;
+    uint32_t frameCount;
+    uint32_t reserved2;
+};
+
+struct AssetPackStats {
+    int entries;
+    int packs;
+    int resident;           // Pack files whose payloads are in memory
+    size_t bytes;           // Mapped or downloaded
+};
+
+// Read-only view of the packed assets. The main pack carries the index of
+// every entry plus the payloads needed before play; the stream pack holds
+// the rest. Natively both are mmapped, so nothing is read until a payload
+// is touched. On the web the main pack is the only preloaded file and the
+// stream pack downloads in the background after open(); entries in it
+// report resident() once it lands.
+// PCM entries load as a copy (or inflate) straight into a Wave. Other
+// formats are kept as the original file and decoded from memory.
+// When no pack opens, find() returns null and callers fall back to loose
+// files under assets/.
+class AssetPack {
+public:
+    static const int MAX_PACKS = 4;
+    static const int PACK_NAME_SIZE = 32;
+
+    enum Format : uint8_t { FORMAT_FILE = 0, FORMAT_PCM = 1 };
+    enum Compression : uint8_t { COMPRESSION_STORED = 0, COMPRESSION_DEFLATE = 1 };
+    enum PackState : uint8_t { PACK_MISSING = 0, PACK_FETCHING, PACK_RESIDENT, PACK_FAILED };
+
+    static AssetPack& instance();
+
+    // Main thread, before any asset is asked for. The other pack files are
+    // looked for next to `path`.
+    bool open(const char* path);
+    void close();
+
+    // Null when not packed (or no pack is open)
+    const AssetPackEntry* find(const char* name) const;
+    PackState state(const AssetPackEntry* entry) const;
+    bool resident(const AssetPackEntry* entry) const { return state(entry) == PACK_RESIDENT; }
+
+    // Any thread, once resident. The samples are the caller's (UnloadWave);
+    // an invalid Wave on a damaged entry.
+    Wave loadWave(const AssetPackEntry* entry) const;
+
+    const AssetPackStats& stats() const { return totals; }
+
+private:
+    struct Pack {
+        char name[PACK_NAME_SIZE];
+        PackState state;
+        const unsigned char* data;
+        size_t size;
+        bool mapped;        // munmap rather than MemFree
+    };
+
+    AssetPack();
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool load(Pack& pack, const char* path);
+    void fetch(int index, const char* url);
+    static void fetched(void* user, void* data, int size);
+    static void fetchFailed(void* user);
+
+    Pack packs[MAX_PACKS];
+    int packCount;
+    const AssetPackEntry* entries;  // Inside the main pack, sorted by name
+    int entryCount;
+    AssetPackStats totals;
+};
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,73 @@
+#ifndef BORSH_H
+#define BORSH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <array>
+#include <optional>
+#include <string_view>
+
+// Minimal Borsh support for the generated component code (bolt_components.h).
+// Borsh is little-endian, like every target we build for (x86, ARM, wasm),
+// so loads and stores are plain memcpys that compile to single moves.
+namespace borsh {
+
+using Pubkey = std::array<uint8_t, 32>;
+
+// Unaligned read of a little-endian scalar; caller has bounds-checked
+template <typename T>
+inline T load(const uint8_t* p) {
+    T value;
+    memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+// Serializes into a caller-owned buffer. Writing past the end sets
+// overflowed() and keeps counting, so a Writer over a null buffer measures
+// the encoded size.
+class Writer {
+public:
+    Writer(uint8_t* buffer, size_t capacity) : buffer(buffer), capacity(capacity), length(0) {}
+
+    template <typename T>
+    void write(T value) {
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBool(bool value) { write<uint8_t>(value ? 1 : 0); }
+    void writePubkey(const Pubkey& key) { writeBytes(key.data(), key.size()); }
+
+    void writeString(std::string_view text) {
+        write<uint32_t>((uint32_t)text.size());
+        writeBytes(text.data(), text.size());
+    }
+
+    template <typename T>
+    void writeOption(const std::optional<T>& value) {
+        write<uint8_t>(value ? 1 : 0);
+        if (value) write<T>(*value);
+    }
+
+    void writeOption(const std::optional<Pubkey>& value) {
+        write<uint8_t>(value ? 1 : 0);
+        if (value) writePubkey(*value);
+    }
+
+    void writeBytes(const void* data, size_t count) {
+        if (buffer && length <= capacity && count <= capacity - length) memcpy(buffer + length, data, count);
+        length += count;
+    }
+
+    size_t size() const { return length; }
+    bool overflowed() const { return length > capacity; }
+
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t length;
+};
+
+} // namespace borsh
+
+#endif // BORSH_H
@@ -0,0 +1,84 @@
+#ifndef BRIDGE_EVENTS_H
+#define BRIDGE_EVENTS_H
+
+#include <stdint.h>
+#include <atomic>
+#include "native_bridge.h"
+
+// The outcome of one bridge call, as the main thread sees it
+struct BridgeEvent {
+    static const int ERROR_SIZE = 64;
+
+    uint32_t sequence;          // Post order
+    uint8_t instruction;        // BridgeInstruction
+    bool success;
+    double submittedAt;         // BridgeLatency::now()
+    double settledAt;
+    char error[ERROR_SIZE];     // Copied; empty on success
+    NativeBridgeCallback callback;
+};
+
+struct BridgeEventStats {
+    uint64_t dispatched;
+    uint32_t lastDispatch;      // Events run by the latest dispatch()
+    uint32_t peakDepth;
+    uint32_t refused;           // Posts turned away by a full queue
+};
+
+// Completion queue between the bridge backends (the web mailbox, the native
+// mock chain) and game code. Backends post every outcome, immediate
+// rejections included, and dispatch() runs the callbacks in post order at
+// one point in the frame. Callbacks therefore never run inside a submit,
+// mid-update, or from a promise, and whatever they change is in place before
+// the systems that read it update. Posting is lock-free and safe from any
+// thread; the error text is copied, so backends can free theirs at once.
+// Latency samples (bridge_latency.h) are recorded here as events dispatch.
+//
+// A callback never runs anywhere but dispatch(). Each backend settles at
+// most MAX_SETTLING requests between two dispatches (its pending table), so
+// CAPACITY leaves room for a frame's worth of those plus thousands of
+// immediate rejections. Should it fill anyway, post() refuses and counts it:
+// a backend keeps the settled request and posts it again on its next poll,
+// and a rejection is dropped (the action queue's deadline fails its
+// transaction).
+class BridgeEvents {
+public:
+    static const int CAPACITY = 1024;       // Power of two
+    static const int MAX_SETTLING = 256;    // Largest backend pending table
+
+    static BridgeEvents& instance();
+
+    // `error` null means success. False, with nothing posted, when the queue
+    // is full.
+    bool post(uint8_t instruction, NativeBridgeCallback callback, double submittedAt, double settledAt,
+              const char* error);
+
+    // Main thread, once per frame. Events posted by the callbacks themselves
+    // wait for the next dispatch. Returns how many ran.
+    int dispatch();
+
+    int depth() const;
+    const BridgeEventStats& stats() const { return totals; }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        BridgeEvent event;
+    };
+
+    BridgeEvents();
+    BridgeEvents(const BridgeEvents&) = delete;
+    BridgeEvents& operator=(const BridgeEvents&) = delete;
+
+    static void run(const BridgeEvent& event);
+
+    // Bounded multi-producer queue: a cell is free for the producer whose
+    // position matches its sequence, and readable once that reaches position + 1
+    Cell cells[CAPACITY];
+    std::atomic<uint32_t> enqueueAt;
+    uint32_t dequeueAt;
+    std::atomic<uint32_t> refused;
+    BridgeEventStats totals;
+};
+
+#endif // BRIDGE_EVENTS_H
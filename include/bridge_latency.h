@@ -0,0 +1,91 @@
+#ifndef BRIDGE_LATENCY_H
+#define BRIDGE_LATENCY_H
+
+#include <stdint.h>
+#include "native_bridge.h"
+
+// HDR-style latency histogram: microsecond values land in log-linear
+// buckets, SUB_BUCKET_COUNT / 2 per power of two, so any value is known to
+// within 1%. Covers 1 us to ~67 s in fixed storage; larger values are
+// clamped (max() stays exact).
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 7;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int BUCKET_COUNT = 20;
+    static const int COUNTS = (BUCKET_COUNT + 1) * (SUB_BUCKET_COUNT / 2);
+
+    void reset();
+    void record(uint64_t micros);
+
+    // Smallest recorded value at least `percentile` (0..100) of samples are
+    // at or below, reported as the upper edge of its bucket
+    uint64_t percentile(double percentile) const;
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? minimum : 0; }
+    uint64_t max() const { return maximum; }
+    double mean() const { return total ? (double)sum / (double)total : 0.0; }
+
+private:
+    static int indexFor(uint64_t value);
+    static uint64_t highestEquivalent(int index);
+
+    uint32_t counts[COUNTS];
+    uint64_t total;
+    uint64_t sum;
+    uint64_t minimum;
+    uint64_t maximum;
+};
+
+// Failures of one instruction, counted by error string
+struct BridgeFailure {
+    static const int ERROR_SIZE = 64;
+    char error[ERROR_SIZE];
+    uint32_t count;
+};
+
+struct BridgeInstructionLatency {
+    static const int MAX_FAILURE_KINDS = 6;
+    LatencyHistogram histogram;     // Successful calls
+    uint32_t failed;
+    BridgeFailure failures[MAX_FAILURE_KINDS];
+    int failureKinds;
+    uint32_t otherFailures;         // Errors past MAX_FAILURE_KINDS distinct strings
+};
+
+// End-to-end time of every bridge call, from the helper (Shoot, JoinGame,
+// UpdateMovement, ...) handing it to SolanaGameBridge until its promise
+// settles, per BridgeInstruction. Samples are recorded as the outcomes
+// dispatch from BridgeEvents (bridge_events.h); on web the settle time is
+// the one JS writes into the mailbox result. F4 shows the overlay, F5
+// exports the JSON report.
+class BridgeLatency {
+public:
+    static const int REPORT_SIZE = 16384;
+
+    static BridgeLatency& instance();
+    static const char* instructionName(int instruction);
+    static double now();     // Milliseconds, same clock as performance.now() on web
+
+    // `error` null means success
+    void record(int instruction, double milliseconds, const char* error);
+    void reset();
+
+    const BridgeInstructionLatency& instruction(int instruction) const { return instructions[instruction]; }
+    uint64_t calls() const;
+
+    // JSON: one object per instruction with samples, failures, p50/p95/p99/max
+    // in ms and the failure counts by error. Returns the length written.
+    int report(char* out, int size) const;
+
+    // Web: console and SolanaGameBridge.onLatencyReport(json) if present.
+    // Native: writes bridge_latency.json to the working directory.
+    void exportReport() const;
+
+private:
+    BridgeLatency();
+
+    BridgeInstructionLatency instructions[BRIDGE_INSTRUCTION_COUNT];
+};
+
+#endif // BRIDGE_LATENCY_H
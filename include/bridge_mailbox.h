@@ -0,0 +1,70 @@
+#ifndef BRIDGE_MAILBOX_H
+#define BRIDGE_MAILBOX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "native_bridge.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Web backend for the contract helpers (shoot.h, movement.h, ...), the
+// counterpart of native_bridge.h. Instead of one EM_ASM call per helper,
+// commands are written into a ring in the wasm heap and JS drains the ring
+// in one call per frame (BridgeMailboxFlush), starting the
+// SolanaGameBridge calls. As promises settle, JS writes results straight
+// into a second ring, which BridgeMailboxPoll reads without leaving wasm.
+// Errors are copied into the result, so nothing is allocated per call on
+// either side of the boundary.
+//
+// The layouts below are read and written by the JS in bridge_mailbox.cpp
+// at fixed offsets; change both together.
+
+typedef void (*BridgeMailboxCallback)(bool success, const char* error);
+
+#define BRIDGE_MAILBOX_ADDRESS_SIZE 48
+#define BRIDGE_MAILBOX_ERROR_SIZE 64
+
+// One instruction (88 bytes). A batch is a header entry (BRIDGE_EXECUTE_BATCH,
+// flag = action count) followed by one entry per action, whose instruction
+// field holds its BatchActionType.
+typedef struct {
+    uint32_t ticket;
+    uint8_t instruction;        // BridgeInstruction
+    uint8_t weaponSlot;
+    uint8_t isHeadshot;
+    uint8_t flag;
+    float args[7];
+    uint16_t payloadOffset;     // Prepared message bytes, in the payload area
+    uint16_t payloadSize;
+    char address[BRIDGE_MAILBOX_ADDRESS_SIZE];
+} BridgeCommand;
+
+// Outcome of one command (80 bytes)
+typedef struct {
+    uint32_t ticket;
+    uint32_t success;
+    double settledAt;           // performance.now() when the promise settled
+    char error[BRIDGE_MAILBOX_ERROR_SIZE];
+} BridgeResult;
+
+// A full mailbox fails the call through `callback`, which like every
+// outcome runs from BridgeEvents::dispatch (bridge_events.h)
+void BridgeMailboxSubmit(const BridgeRequest* request, BridgeMailboxCallback callback);
+void BridgeMailboxSubmitBatch(const struct BatchAction* actions, int count, BridgeMailboxCallback callback);
+void BridgeMailboxSubmitMessage(const uint8_t* message, uint32_t size, BridgeMailboxCallback callback);
+
+// Posts everything that settled since the last poll to BridgeEvents. Call
+// once per frame, where NativeBridgePoll runs natively.
+void BridgeMailboxPoll(void);
+
+// Hands everything submitted since the last flush to JS. Call once per
+// frame, after the action queue pumps.
+void BridgeMailboxFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BRIDGE_MAILBOX_H
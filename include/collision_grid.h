@@ -0,0 +1,49 @@
+#ifndef COLLISION_GRID_H
+#define COLLISION_GRID_H
+
+#include <raylib.h>
+#include <vector>
+#include "map.h"
+
+// The map's walls and platforms as boxes bucketed into a uniform grid over
+// the ground, for sweeping many short segments (projectiles moving one
+// tick) against the level. A sweep walks only the cells the segment
+// crosses, nearest first, and stops at the first cell that holds a hit, so
+// its cost follows the segment's length rather than the size of the map.
+// The ground plane counts as geometry everywhere, inside the grid or not.
+// Built once the map is loaded; read-only afterwards, so any number of
+// threads can sweep at once.
+class CollisionGrid {
+public:
+    static constexpr float CELL_SIZE = 4.0f;
+    static const int MAX_CELLS_PER_SIDE = 128;  // Larger maps get larger cells
+
+    CollisionGrid();
+
+    void build(const Map& map);
+
+    // First hit on the segment from-to, as a fraction of its length (0 when
+    // `from` is already inside a box). False if it's clear.
+    bool sweep(Vector3 from, Vector3 to, float& fraction) const;
+
+    int boxCount() const { return (int)minX.size(); }
+
+private:
+    float segmentBox(int box, Vector3 from, Vector3 delta, float maxFraction) const;
+
+    // Per box
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    // Cell c holds boxes refs[cellStart[c]] .. refs[cellStart[c + 1] - 1]; row-major, x fastest
+    std::vector<int> cellStart;
+    std::vector<int> refs;
+    float originX;
+    float originZ;
+    float cellSize;
+    int columns;
+    int rows;
+    float groundHeight;
+};
+
+#endif // COLLISION_GRID_H
@@ -0,0 +1,57 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include <raylib.h>
+#include <vector>
+#include "job_system.h"
+
+// Particle structures for effects
+struct BulletTracer {
+    Vector3 start;
+    Vector3 end;
+    float lifetime;
+    Color color;
+};
+
+struct ImpactParticle {
+    Vector3 position;
+    Vector3 velocity;
+    float lifetime;
+    float maxLifetime;
+    Color color;
+};
+
+// Tracers and particles live in pools reserved up front; spawns beyond
+// capacity are dropped so steady-state frames never touch the heap.
+// Particles integrate in parallel on the JobSystem; removing the expired
+// ones is a single job after that.
+class Effects {
+public:
+    static const int DEFAULT_MAX_TRACERS = 64;
+    static const int DEFAULT_MAX_PARTICLES = 2048;
+    static const int PARTICLE_GRAIN = 256;     // Fewer particles than this integrate in one job
+    
+    std::vector<BulletTracer> bulletTracers;
+    std::vector<ImpactParticle> impactParticles;
+    size_t maxTracers;
+    size_t maxParticles;
+    
+    Effects(int tracerCapacity = DEFAULT_MAX_TRACERS, int particleCapacity = DEFAULT_MAX_PARTICLES);
+    void spawnTracer(Vector3 start, Vector3 end);
+    void spawnImpact(Vector3 hitPoint);
+    void update(float deltaTime);
+    // Starts update() as jobs, counted on `done`. Nothing may touch the
+    // effects (spawn or draw included) until it is done.
+    void beginUpdate(float deltaTime, JobCounter& done);
+    void draw();
+    void clear();
+
+private:
+    static void integrateParticles(void* data, int begin, int end);
+    static void removeExpired(void* data, int begin, int end);
+
+    float stepTime;         // deltaTime of the update in flight
+    JobCounter integrated;
+};
+
+#endif // EFFECTS_H
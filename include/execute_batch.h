@@ -0,0 +1,53 @@
+#ifndef EXECUTE_BATCH_H
+#define EXECUTE_BATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "native_bridge.h"
+#include "bridge_mailbox.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*ExecuteBatchCallback)(bool success, const char* error);
+
+// Gameplay instructions that can share one transaction
+typedef enum {
+    BATCH_ACTION_MOVEMENT = 0,
+    BATCH_ACTION_SHOOT = 1,
+    BATCH_ACTION_RELOAD = 2,
+    BATCH_ACTION_SWITCH_WEAPON = 3,
+    BATCH_ACTION_APPLY_DAMAGE = 4
+} BatchActionType;
+
+// One instruction in a batch
+// movement:      args = x, y, z, rotation, velocityX, velocityY, velocityZ
+// shoot/reload/switch weapon: weaponSlot
+// apply damage:  victimAddress, weaponSlot (weapon type), isHeadshot, args[0] = distance
+typedef struct BatchAction {
+    uint8_t type;               // BatchActionType
+    uint8_t weaponSlot;
+    uint8_t isHeadshot;
+    uint8_t reserved;
+    float args[7];
+    const char* victimAddress;  // base58 string, apply damage only
+} BatchAction;
+
+// Send `count` instructions as a single transaction.
+// Uses SolanaGameBridge.executeBatch when the bridge provides it; older
+// bridges get the individual calls, resolved together.
+static inline void ExecuteBatch(const BatchAction* actions, int count, ExecuteBatchCallback callback) {
+#ifdef PLATFORM_WEB
+    BridgeMailboxSubmitBatch(actions, count, callback);
+#else
+    NativeBridgeSubmitBatch(actions, count, callback);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EXECUTE_BATCH_H
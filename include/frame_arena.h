@@ -0,0 +1,62 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <stddef.h>
+
+// Debug builds fill released memory so stale pointers into last frame's
+// data show up as 0xCD garbage instead of silently reading old values
+#ifndef FRAME_ARENA_POISON
+#   ifdef NDEBUG
+#       define FRAME_ARENA_POISON 0
+#   else
+#       define FRAME_ARENA_POISON 1
+#   endif
+#endif
+
+// Bump-pointer allocator for data that only lives until the end of the
+// frame: the HUD's strings. Allocation is a pointer bump, freeing is a
+// no-op, and reset() (after EndDrawing) releases everything at once. If a frame outgrows the buffer, the excess
+// falls back to malloc and is freed on reset; overflowCount() reports it.
+class FrameArena {
+public:
+    static const size_t DEFAULT_CAPACITY = 256 * 1024;
+    
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    void* allocate(size_t size, size_t alignment = alignof(max_align_t));
+    
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+    
+    // printf into arena memory; the string is valid until reset()
+    const char* format(const char* fmt, ...);
+    
+    void reset();
+    
+    size_t used() const { return offset; }
+    size_t capacity() const { return bufferSize; }
+    size_t highWater() const { return peak; }
+    size_t overflowCount() const { return overflows; }
+    
+    // Arena shared by the game loop, reset once per frame
+    static FrameArena& frame();
+    
+private:
+    struct OverflowBlock {
+        OverflowBlock* next;
+    };
+    
+    unsigned char* buffer;
+    size_t bufferSize;
+    size_t offset;
+    size_t peak;
+    size_t overflows;
+    OverflowBlock* overflowBlocks;
+};
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,78 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "privy_bridge.h"
+#include "player.h"
+#include "map.h"
+#include "gun.h"
+#include "mobile_controls.h"
+#include "effects.h"
+#include "job_system.h"
+#include "movement_sync.h"
+#include "player_roster.h"
+#include "positional_audio.h"
+#include "hitboxes.h"
+#include "collision_grid.h"
+#include "projectiles.h"
+
+enum GamePhase {
+    PHASE_LOADING = 0,      // Progress screen until the critical assets are in
+    PHASE_PLAYING
+};
+
+// Everything that lives from one frame to the next. On the web main()
+// hands control back to the browser, which then calls its frame function
+// once per animation frame, so none of this can sit on main()'s stack.
+//
+// A frame is input (the live game's, or the timedemo's script), then
+// step(), then drawScene() and drawHUD() inside a drawing pass. The game
+// and the timedemo share everything from step() on, so the timedemo's
+// allocation check covers the same per-frame code the game runs.
+struct Game {
+    GamePhase phase = PHASE_LOADING;
+    bool audioReady = false;
+    bool isMobile = false;
+    MobileControls mobileControls;
+
+    // Wallet state
+    bool walletConnected = false;
+    char walletAddress[PrivyBridge::WALLET_ADDRESS_SIZE] = "";
+    double solBalance = 0.0;
+    uint32_t walletVersion = 0;
+
+    // Game objects
+    Player player;
+    Map map;
+    Gun gun;
+    float playerRadius = 0.4f;
+
+    // Effects system; particles integrate on the job system while the rest of the frame runs
+    Effects effects;
+    JobCounter effectsUpdated;
+
+    // F3 shows the action queue counters, F4 bridge latency
+    MovementSync movementSync;
+    bool showNetworkStats = false;
+    bool showBridgeLatency = false;
+
+    PlayerRoster roster;
+    PositionalAudio remoteAudio; // Other players' footsteps and shots, placed around the camera
+    Hitboxes hitboxes;          // Remote players, as drawn this frame, for shots and projectiles
+    CollisionGrid mapGrid;      // The map's boxes, for sweeping projectiles
+    Projectiles projectiles;    // Stepped on the job system alongside the particles
+    JobCounter projectilesStepped;
+
+    // After input and the bridge backend's poll: fires the shot the input
+    // asked for, steps projectiles and particles, runs the bridge callbacks,
+    // sends queued actions and updates the roster and audio
+    void step(float deltaTime);
+
+    // Inside BeginDrawing or BeginTextureMode: the world, then the gun over it
+    void drawScene();
+    // Crosshair, weapon, health, wallet and the F3/F4 overlays
+    void drawHUD(int width, int height);
+};
+
+#endif // GAME_H
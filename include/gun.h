@@ -2,6 +2,8 @@
 #define GUN_H
 
 #include <raylib.h>
+#include "sound_bank.h"
+#include "weapons.h"
 
 class Gun {
 public:
@@ -12,20 +14,24 @@ public:
     float bobSpeed;
     float recoilAngle;
     bool isRecoiling;
+    float kickAngle;    // recoilAngle right after the last shot
+    float flashScale;   // The last shot's weapon's muzzle flash size
     float sprintTilt; // Rotation when sprinting
     float sprintOffset; // Position offset when sprinting (move to center/side)
     float sprintSway; // Left-right sway during sprint
-    Sound shootSound;
-    int currentSoundIndex;
-    static const int MAX_SOUND_INSTANCES = 4;
-    Sound shootSoundInstances[MAX_SOUND_INSTANCES];
+    static const int MAX_SOUND_INSTANCES = 4; // Overlapping shots
+    SoundId shootSounds[WEAPON_COUNT];  // By WeaponId, shared through SoundBank
+    bool ownsShootSound[WEAPON_COUNT];  // False where an earlier weapon uses the same file
     
     Gun();
     ~Gun();
     void update(float deltaTime, bool isMoving, bool isShooting, bool isSprinting, bool isCrouching);
     void draw(Camera3D camera);
     void drawSimple(Camera3D camera); // Simple gun for now without model
-    void applyRecoil();
+    void applyRecoil(float kick, float flashSize, SoundId sound, float volume); // One shot's kick, flash and report
+    float flashIntensity() const { return kickAngle > 0.0f ? recoilAngle / kickAngle : 0.0f; } // 1 at the shot, fading to 0
+    Vector3 getMuzzlePosition(Camera3D camera); // Barrel tip at rest, where shots start
+    void drawMuzzleLight(Camera3D camera);      // World-space flash lighting while recoiling
 };
 
 #endif // GUN_H
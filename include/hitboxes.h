@@ -0,0 +1,80 @@
+#ifndef HITBOXES_H
+#define HITBOXES_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "map.h"
+#include "player_roster.h"
+
+enum HitRegion : uint8_t {
+    HIT_NONE = 0,
+    HIT_WALL,
+    HIT_HEAD,
+    HIT_BODY,
+    HIT_LIMB
+};
+
+// What one shot hit first
+struct ShotHit {
+    HitRegion region;       // HIT_NONE: nothing within range
+    int player;             // The id given to add(); -1 for walls and misses
+    float distance;         // Along the ray
+    Vector3 point;
+};
+
+// Hit geometry for a set of players, rebuilt from their positions whenever
+// shots are tested: a head sphere, a body capsule and four limb capsules
+// each, sized to the figure PlayerRoster draws. Everything is kept in flat
+// arrays so a ray first runs through one bounding sphere per player, and
+// only the players it passes near get their parts tested. Walls are tested
+// first and cap the range, so shots through cover stop at the cover.
+// raycastBatch() spreads many rays over the JobSystem, for checking every
+// shot fired in a tick at once.
+class Hitboxes {
+public:
+    static const int MAX_PLAYERS = 64;
+    static const int LIMBS = 4;                 // Arms, then legs
+    static const int BATCH_GRAIN = 64;          // Rays per job
+
+    Hitboxes();
+
+    void clear();
+    // `eye` is eye height, as in Position accounts; `yaw` as Player::yaw.
+    // False when full.
+    bool add(Vector3 eye, float yaw, int id);
+    // Every remote player that is alive and placed, where it is drawn; ids are roster indices
+    void fromRoster(const PlayerRoster& roster);
+
+    // Nearest hit within maxDistance, walls of `map` (if any) included.
+    // `ray.direction` must be normalized.
+    ShotHit raycast(Ray ray, float maxDistance, const Map* map) const;
+    void raycastBatch(const Ray* rays, int count, float maxDistance, const Map* map, ShotHit* hits) const;
+
+    int count() const { return players; }
+
+private:
+    static void raycastJob(void* data, int begin, int end);
+
+    // Per player
+    float boundX[MAX_PLAYERS];
+    float boundY[MAX_PLAYERS];
+    float boundZ[MAX_PLAYERS];
+    float headX[MAX_PLAYERS];
+    float headY[MAX_PLAYERS];
+    float headZ[MAX_PLAYERS];
+    float bodyTop[MAX_PLAYERS];     // The body capsule is upright: x/z of the head, these heights
+    float bodyBottom[MAX_PLAYERS];
+
+    // Per limb, player-major: segment ends
+    float limbAX[MAX_PLAYERS * LIMBS];
+    float limbAY[MAX_PLAYERS * LIMBS];
+    float limbAZ[MAX_PLAYERS * LIMBS];
+    float limbBX[MAX_PLAYERS * LIMBS];
+    float limbBY[MAX_PLAYERS * LIMBS];
+    float limbBZ[MAX_PLAYERS * LIMBS];
+
+    int ids[MAX_PLAYERS];
+    int players;
+};
+
+#endif // HITBOXES_H
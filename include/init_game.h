@@ -3,9 +3,8 @@
 
 #include <stdbool.h>
 
-#ifdef PLATFORM_WEB
-#include <emscripten.h>
-#endif
+#include "native_bridge.h"
+#include "bridge_mailbox.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,31 +13,12 @@ extern "C" {
 typedef void (*InitGameCallback)(bool success, const char* error);
 
 static inline void InitGame(InitGameCallback callback) {
+    BridgeRequest request = { 0 };
+    request.instruction = BRIDGE_INIT_GAME;
 #ifdef PLATFORM_WEB
-    EM_ASM({
-        const callback = $0;
-        
-        if (!window.SolanaGameBridge) {
-            const errorMsg = "SolanaGameBridge not initialized";
-            const errorPtr = allocateUTF8(errorMsg);
-            Module.dynCall_vii(callback, 0, errorPtr);
-            _free(errorPtr);
-            return;
-        }
-        
-        window.SolanaGameBridge.initGame()
-            .then(() => {
-                Module.dynCall_vii(callback, 1, 0);
-            })
-            .catch(err => {
-                const errorMsg = err.message || "Init game failed";
-                const errorPtr = allocateUTF8(errorMsg);
-                Module.dynCall_vii(callback, 0, errorPtr);
-                _free(errorPtr);
-            });
-    }, callback);
+    BridgeMailboxSubmit(&request, callback);
 #else
-    callback(false, "Web platform only");
+    NativeBridgeSubmit(&request, callback);
 #endif
 }
 
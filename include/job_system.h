@@ -0,0 +1,100 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// A job is a function over an index range of some shared data
+typedef void (*JobFunction)(void* data, int begin, int end);
+
+// Jobs still to finish. Every job submitted with a counter raises it and
+// drops it when done; a job submitted `after` a counter waits for zero.
+// Must outlive the jobs that use it.
+struct JobCounter {
+    std::atomic<int> pending{0};
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// Frame-time jobs: integration, batches of independent updates. Each
+// thread owns a queue; it pushes and pops at the back (newest first, still
+// in cache), and idle threads steal from the front of the others. The
+// main thread is thread 0 and runs jobs too while it waits.
+// Natively (and on WEB_THREADS builds) there is a worker per spare core up
+// to MAX_WORKERS. With none,
+// jobs run on the main thread when it waits, so callers look the same.
+// Jobs must not block: asset loading has its own threads (asset_loader.h).
+class JobSystem {
+public:
+    static const int MAX_WORKERS = 7;
+    static const int QUEUE_SIZE = 256;      // Per thread; a push to a full queue runs inline
+    static const int MAX_DEFERRED = 64;     // Jobs waiting on a counter
+
+    static JobSystem& instance();
+
+    void start();
+    void stop();        // Runs what's queued, then joins
+    int threadCount() const { return workerCount + 1; }
+
+    // fn(data, begin, end), once `after` (if given) is done. `done` (if
+    // given) counts it until it returns.
+    void run(JobFunction fn, void* data, int begin, int end, JobCounter* done, JobCounter* after = nullptr);
+
+    // [0, count) in ranges of at least `grain` items, at most one per thread
+    void parallelFor(int count, int grain, JobFunction fn, void* data, JobCounter* done,
+                     JobCounter* after = nullptr);
+
+    // Runs queued jobs until `counter` is done
+    void wait(const JobCounter& counter);
+
+private:
+    struct Job {
+        JobFunction fn;
+        void* data;
+        int begin;
+        int end;
+        JobCounter* done;
+    };
+
+    struct Queue {
+        std::mutex lock;
+        Job jobs[QUEUE_SIZE];
+        uint32_t front;     // Thieves take here
+        uint32_t back;      // The owner pushes and pops here
+    };
+
+    struct Deferred {
+        Job job;
+        JobCounter* after;
+    };
+
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void push(const Job& job);
+    bool pop(int thread, Job& job);
+    bool steal(int thread, Job& job);
+    bool runOne(int thread);
+    void execute(const Job& job);
+    void workerLoop(int thread);
+
+    Queue queues[MAX_WORKERS + 1];
+    std::atomic<int> queued;
+
+    std::mutex deferredLock;
+    Deferred deferred[MAX_DEFERRED];
+    int deferredCount;
+
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::thread workers[MAX_WORKERS];
+    int workerCount;
+    bool stopping;
+};
+
+#endif // JOB_SYSTEM_H
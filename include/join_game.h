@@ -3,9 +3,8 @@
 
 #include <stdbool.h>
 
-#ifdef PLATFORM_WEB
-#include <emscripten.h>
-#endif
+#include "native_bridge.h"
+#include "bridge_mailbox.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,32 +13,13 @@ extern "C" {
 typedef void (*JoinGameCallback)(bool success, const char* error);
 
 static inline void JoinGame(const char* gameAddress, JoinGameCallback callback) {
+    BridgeRequest request = { 0 };
+    request.instruction = BRIDGE_JOIN_GAME;
+    request.address = gameAddress;
 #ifdef PLATFORM_WEB
-    EM_ASM({
-        const gameAddr = UTF8ToString($0);
-        const callback = $1;
-        
-        if (!window.SolanaGameBridge) {
-            const errorMsg = "SolanaGameBridge not initialized";
-            const errorPtr = allocateUTF8(errorMsg);
-            Module.dynCall_vii(callback, 0, errorPtr);
-            _free(errorPtr);
-            return;
-        }
-        
-        window.SolanaGameBridge.joinGame(gameAddr)
-            .then(() => {
-                Module.dynCall_vii(callback, 1, 0);
-            })
-            .catch(err => {
-                const errorMsg = err.message || "Join game failed";
-                const errorPtr = allocateUTF8(errorMsg);
-                Module.dynCall_vii(callback, 0, errorPtr);
-                _free(errorPtr);
-            });
-    }, gameAddress, callback);
+    BridgeMailboxSubmit(&request, callback);
 #else
-    callback(false, "Web platform only");
+    NativeBridgeSubmit(&request, callback);
 #endif
 }
 
@@ -28,6 +28,7 @@ public:
     void draw();
     void drawSolanaLogo();
     bool checkCollision(Vector3 playerPos, float playerRadius, Vector3& correction);
+    bool raycastWalls(Ray ray, float maxDistance, Vector3& hitPoint) const; // Nearest wall hit within maxDistance
     float getGroundHeight(Vector3 position);
 };
 
@@ -0,0 +1,202 @@
+#ifndef MOCK_CHAIN_H
+#define MOCK_CHAIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "native_bridge.h"
+
+// Injected network behaviour; see native_bridge.h for the matching env vars
+struct MockChainConfig {
+    double latencyMs;
+    double jitterMs;
+    double failureRate;
+    uint32_t seed;
+    int botCount;
+
+    static MockChainConfig defaults();
+    static MockChainConfig fromEnvironment();
+};
+
+// Component state, field for field with idl/*.json (pubkeys and strings that
+// the rules never read are left out; timestamps are mock seconds)
+struct MockPosition {
+    double x, y, z;
+    float rotationX, rotationY;
+    float velocityX, velocityY, velocityZ;
+    bool isJumping;
+    bool isMoving;
+    uint8_t spawnPointId;
+};
+
+struct MockHealth {
+    uint32_t maxHp;
+    uint32_t currentHp;
+    uint32_t armor;
+    uint32_t maxArmor;
+    bool isAlive;
+    int64_t lastDamageTimestamp;
+    uint32_t lastDamageAmount;
+};
+
+struct MockWeapon {
+    uint8_t currentWeapon;
+    uint32_t primaryAmmo;
+    uint32_t primaryAmmoReserve;
+    uint32_t secondaryAmmo;
+    uint32_t secondaryAmmoReserve;
+    uint32_t primaryDamage;
+    uint32_t secondaryDamage;
+    bool canSwitchWeapon;
+    uint32_t reloadTime;
+    int64_t lastShotTimestamp;
+    bool isReloading;
+};
+
+struct MockPlayer {
+    bool hasLoggedIn;
+    uint8_t team;
+    bool inGame;            // current_game is Some
+    bool isAlive;
+    uint32_t totalMatchesPlayed;
+    uint32_t level;
+    bool isReady;
+};
+
+struct MockPlayerStats {
+    uint32_t kills;
+    uint32_t deaths;
+    uint32_t assists;
+    uint32_t headshots;
+    uint32_t damageTaken;
+    uint32_t damageDealt;
+    uint32_t roundWins;
+    float kdaRatio;
+    uint32_t killStreak;
+    uint32_t highestKillStreak;
+};
+
+struct MockGame {
+    uint32_t teamAScore;
+    uint32_t teamBScore;
+    uint32_t matchDuration;
+    int64_t matchStartTimestamp;
+    int64_t matchEndTimestamp;
+    uint8_t gameState;      // GAME_WAITING, GAME_IN_PROGRESS, GAME_ENDED
+    uint8_t maxPlayersPerTeam;
+    uint8_t currentPlayersTeamA;
+    uint8_t currentPlayersTeamB;
+    uint8_t readyPlayers;
+};
+
+// One player entity and its components
+struct MockEntity {
+    static const int ADDRESS_SIZE = 48;
+
+    char address[ADDRESS_SIZE];
+    MockPlayer player;
+    MockPosition position;
+    MockHealth health;
+    MockWeapon weapon;
+    MockPlayerStats stats;
+};
+
+// Receives Borsh-encoded account data whenever a component changes, like an
+// accountSubscribe notification. `address` is "<entity>/<component>".
+typedef void (*MockAccountListener)(const char* address, const char* entity, uint64_t slot,
+                                    const uint8_t* data, size_t size);
+
+// In-process stand-in for the Bolt world: the local player, a few bots on
+// the other team and one game, already started. Transactions are applied
+// atomically when their latency has elapsed, following the checks (and
+// error messages) of the programs in idl/*.json. Bots jog around their spawn
+// points. Storage is fixed-size; submitting never allocates.
+class MockChain {
+public:
+    static const int MAX_ENTITIES = 16;
+    static const int MAX_PENDING = 256;
+    static const int MAX_BATCH_ACTIONS = 8;
+    static const int LOCAL_PLAYER = 0;
+    static constexpr double FEED_INTERVAL = 0.1;   // Seconds between bot moves and account notifications
+
+    enum GameState : uint8_t { GAME_WAITING = 0, GAME_IN_PROGRESS = 1, GAME_ENDED = 2 };
+
+    struct Counters {
+        uint64_t submitted;
+        uint64_t confirmed;
+        uint64_t failed;            // Rejected by a program check
+        uint64_t injectedFailures;  // Dropped by the failure rate
+        uint64_t backlogFull;       // Rejected because MAX_PENDING were in flight
+    };
+
+    static MockChain& instance();
+
+    void configure(const MockChainConfig& config);
+    const MockChainConfig& config() const { return settings; }
+    void resetState();   // Back to the genesis world; pending transactions are dropped
+
+    void submit(const BridgeRequest& request, NativeBridgeCallback callback);
+    void submitBatch(const BridgeRequest* requests, int count, NativeBridgeCallback callback);
+
+    // Changed accounts are pushed from poll(), at most once per FEED_INTERVAL.
+    // Setting a listener replays the whole world to it first.
+    void setAccountListener(MockAccountListener listener);
+
+    // Advances the mock clock to `now` (seconds) and lands due transactions
+    // in order, posting their outcomes to BridgeEvents. Returns how many landed.
+    int poll(double now);
+
+    double now() const { return clock; }
+    uint64_t slot() const { return currentSlot; }   // Bumped by every applied transaction
+    int pendingCount() const { return pending; }
+    const Counters& counters() const { return totals; }
+
+    int entityCount() const { return entities; }
+    const MockEntity& entity(int index) const { return world[index]; }
+    const MockGame& game() const { return state; }
+    int findEntity(const char* address) const;
+
+private:
+    struct PendingTransaction {
+        bool active;
+        uint8_t instruction;        // BridgeInstruction; BRIDGE_EXECUTE_BATCH for batches
+        uint64_t sequence;
+        double submittedAt;         // BridgeLatency::now()
+        double readyAt;
+        int count;
+        BridgeRequest requests[MAX_BATCH_ACTIONS];
+        char addresses[MAX_BATCH_ACTIONS][MockEntity::ADDRESS_SIZE];
+        NativeBridgeCallback callback;
+        bool executed;              // Landed; still here only while BridgeEvents is full
+        const char* error;          // Its outcome, once executed (static text)
+    };
+
+    MockChain();
+    void submitTransaction(const BridgeRequest* requests, int count, uint8_t instruction, NativeBridgeCallback callback);
+    PendingTransaction* reserve(uint8_t instruction, NativeBridgeCallback callback);
+    const char* execute(const PendingTransaction& transaction);
+    const char* apply(const BridgeRequest& request);
+    double nextRandom();
+    void moveBots();
+    void publishAccounts(bool everything);
+
+    MockAccountListener accountListener;
+    MockEntity published[MAX_ENTITIES];   // World as last pushed to the listener
+    MockGame publishedGame;
+    double lastFeedTick;
+
+    MockChainConfig settings;
+    double clock;
+    uint64_t currentSlot;
+    uint64_t sequence;
+    uint64_t rngState;
+
+    MockEntity world[MAX_ENTITIES];
+    int entities;
+    MockGame state;
+
+    PendingTransaction queue[MAX_PENDING];
+    int pending;
+    Counters totals;
+};
+
+#endif // MOCK_CHAIN_H
@@ -4,9 +4,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-#ifdef PLATFORM_WEB
-#include <emscripten.h>
-#endif
+#include "native_bridge.h"
+#include "bridge_mailbox.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,40 +27,19 @@ static inline void UpdateMovement(
     float velocityZ,
     MovementCallback callback
 ) {
+    BridgeRequest request = { 0 };
+    request.instruction = BRIDGE_UPDATE_MOVEMENT;
+    request.args[0] = x;
+    request.args[1] = y;
+    request.args[2] = z;
+    request.args[3] = rotation;
+    request.args[4] = velocityX;
+    request.args[5] = velocityY;
+    request.args[6] = velocityZ;
 #ifdef PLATFORM_WEB
-    EM_ASM({
-        const x = $0;
-        const y = $1;
-        const z = $2;
-        const rotation = $3;
-        const velocityX = $4;
-        const velocityY = $5;
-        const velocityZ = $6;
-        const callback = $7;
-        
-        if (!window.SolanaGameBridge) {
-            const errorMsg = "SolanaGameBridge not initialized";
-            const errorPtr = allocateUTF8(errorMsg);
-            Module.dynCall_vii(callback, 0, errorPtr);
-            _free(errorPtr);
-            return;
-        }
-        
-        window.SolanaGameBridge.updateMovement(
-            x, y, z, rotation, velocityX, velocityY, velocityZ
-        )
-            .then(() => {
-                Module.dynCall_vii(callback, 1, 0);
-            })
-            .catch(err => {
-                const errorMsg = err.message || "Update movement failed";
-                const errorPtr = allocateUTF8(errorMsg);
-                Module.dynCall_vii(callback, 0, errorPtr);
-                _free(errorPtr);
-            });
-    }, x, y, z, rotation, velocityX, velocityY, velocityZ, callback);
+    BridgeMailboxSubmit(&request, callback);
 #else
-    callback(false, "Web platform only");
+    NativeBridgeSubmit(&request, callback);
 #endif
 }
 
@@ -0,0 +1,61 @@
+#ifndef MOVEMENT_SYNC_H
+#define MOVEMENT_SYNC_H
+
+#include <raylib.h>
+#include <stdint.h>
+
+struct MovementSyncStats {
+    uint32_t ticks;     // Ticks evaluated
+    uint32_t sent;      // Ticks that produced an UpdateMovement
+    float lastError;    // Dead-reckoning position error at the last tick
+};
+
+// Replicates the local player's movement through the ActionQueue.
+// Remote clients extrapolate from the last update (position + velocity * t,
+// rotation held), so an update is only needed when that prediction is off
+// by more than the thresholds, the input flags change, or the heartbeat
+// interval passes. Checks run at a fixed tick rate, never every frame.
+// A player standing still or running in a straight line sends nothing
+// between heartbeats.
+class MovementSync {
+public:
+    static constexpr float DEFAULT_TICK_RATE = 10.0f;            // Hz
+    static constexpr float DEFAULT_POSITION_THRESHOLD = 0.25f;   // World units
+    static constexpr float DEFAULT_ANGLE_THRESHOLD = 0.0873f;    // Radians (5 degrees)
+    static constexpr float DEFAULT_HEARTBEAT = 5.0f;             // Seconds, 0 disables
+
+    MovementSync();
+
+    void setTickRate(float hz);
+    void setThresholds(float position, float angle);
+    void setHeartbeat(float seconds);
+
+    // Call once per frame with the player's final position for the frame
+    void update(float deltaTime, Vector3 position, float rotation, Vector3 velocity, uint8_t flags);
+
+    // Forget the last update so the next tick always sends (e.g. after a respawn)
+    void reset();
+
+    const MovementSyncStats& stats() const { return counters; }
+
+private:
+    bool needsUpdate(Vector3 position, float rotation, uint8_t flags) const;
+
+    float tickInterval;
+    float positionThreshold;
+    float angleThreshold;
+    float heartbeat;
+    float tickTimer;
+
+    // What remote clients last received, and how long ago
+    bool hasSent;
+    Vector3 sentPosition;
+    Vector3 sentVelocity;
+    float sentRotation;
+    uint8_t sentFlags;
+    float timeSinceSend;
+
+    MovementSyncStats counters;
+};
+
+#endif // MOVEMENT_SYNC_H
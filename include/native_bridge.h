@@ -0,0 +1,81 @@
+#ifndef NATIVE_BRIDGE_H
+#define NATIVE_BRIDGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Off-web backend for the contract helpers (shoot.h, movement.h, ...).
+// Requests go to an in-process mock of the Bolt components (see
+// mock_chain.h) and land after an injected latency, from NativeBridgePoll;
+// their callbacks run from BridgeEvents::dispatch (bridge_events.h). Disabled unless SOLFPS_MOCK_CHAIN is set,
+// in which case every helper fails with "Web platform only" as before.
+//
+// Environment:
+//   SOLFPS_MOCK_CHAIN=1              enable the mock chain
+//   SOLFPS_MOCK_LATENCY_MS=400       base confirmation latency
+//   SOLFPS_MOCK_JITTER_MS=150        extra uniform random latency
+//   SOLFPS_MOCK_FAILURE_RATE=0.02    fraction of transactions dropped
+//   SOLFPS_MOCK_SEED=1               RNG seed for jitter and failures
+//   SOLFPS_MOCK_BOTS=4               opposing players in the mock game
+
+typedef void (*NativeBridgeCallback)(bool success, const char* error);
+
+// Also identifies the instruction in latency samples (bridge_latency.h),
+// web included
+typedef enum {
+    BRIDGE_INIT_PLAYER = 0,
+    BRIDGE_INIT_GAME,
+    BRIDGE_JOIN_GAME,
+    BRIDGE_LEAVE_GAME,
+    BRIDGE_SET_READY,
+    BRIDGE_START_GAME,
+    BRIDGE_END_GAME,
+    BRIDGE_UPDATE_MOVEMENT,
+    BRIDGE_SHOOT,
+    BRIDGE_RELOAD,
+    BRIDGE_SWITCH_WEAPON,
+    BRIDGE_APPLY_DAMAGE,
+    BRIDGE_RESPAWN,
+    BRIDGE_EXECUTE_BATCH,
+    BRIDGE_SEND_PREPARED,       // TxTemplates message; web only
+    BRIDGE_INSTRUCTION_COUNT
+} BridgeInstruction;
+
+// One instruction and its arguments
+// movement:      args = x, y, z, rotation, velocityX, velocityY, velocityZ
+// shoot/reload/switch weapon: weaponSlot
+// apply damage:  address = victim, weaponSlot = weapon type, isHeadshot, args[0] = distance
+// join game:     address = game
+// set ready:     flag = isReady
+typedef struct {
+    uint8_t instruction;    // BridgeInstruction
+    uint8_t weaponSlot;
+    uint8_t isHeadshot;
+    uint8_t flag;
+    float args[7];
+    const char* address;
+} BridgeRequest;
+
+struct BatchAction;
+
+bool NativeBridgeEnabled(void);
+void NativeBridgeSetEnabled(bool enabled);
+
+// Queue a transaction; `callback` runs from a BridgeEvents::dispatch after
+// the NativeBridgePoll that lands it, or after the submit if it is rejected
+// outright. Strings in the request are copied.
+void NativeBridgeSubmit(const BridgeRequest* request, NativeBridgeCallback callback);
+void NativeBridgeSubmitBatch(const struct BatchAction* actions, int count, NativeBridgeCallback callback);
+
+// Confirm everything whose latency has elapsed. Call once per frame.
+void NativeBridgePoll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NATIVE_BRIDGE_H
@@ -3,6 +3,20 @@
 
 #include <raylib.h>
 #include <raymath.h>
+#include <stdint.h>
+#include "sound_bank.h"
+#include "weapon_prediction.h"
+#include "weapons.h"
+
+// Movement input bits, replicated with the player's movement
+enum MovementFlag : uint8_t {
+    MOVE_FORWARD = 1 << 0,
+    MOVE_BACK    = 1 << 1,
+    MOVE_LEFT    = 1 << 2,
+    MOVE_RIGHT   = 1 << 3,
+    MOVE_JUMP    = 1 << 4,
+    MOVE_CROUCH  = 1 << 5
+};
 
 class Player {
 public:
@@ -22,6 +36,7 @@ public:
     float crouchHeight;
     float standingHeight;
     float currentHeight; // Smoothly interpolated height
+    uint8_t movementFlags; // MovementFlag bits from this frame's input
     
     // Health system
     float health;
@@ -30,19 +45,23 @@ public:
     float damageFlashTimer;
     
     // Gun state
-    bool isShooting;
+    bool isShooting;        // Trigger pulled this frame; the caller fires and clears it
     float shootCooldown;
-    int ammo;
+    int ammo;               // Predicted magazine of the equipped weapon, from weapon
     int maxAmmo;
-    float recoilOffset;
+    WeaponPrediction weapon;
+    uint8_t weaponSlot;     // Equipped: 1 = primary, 2 = secondary
+    const WeaponDef* weaponDef;
+    FireFunction fire;      // weaponDef's fire code, resolved on switching
+    int recoilShot;         // Shots into the current burst, for the recoil pattern
+    double lastShotTime;
     
     // Footstep audio
     static const int MAX_FOOTSTEP_SOUNDS = 9;
     static const int MAX_FOOTSTEP_INSTANCES = 4; // Multi-channel support
-    Sound footstepSounds[MAX_FOOTSTEP_SOUNDS];
-    Sound footstepInstances[MAX_FOOTSTEP_SOUNDS][MAX_FOOTSTEP_INSTANCES]; // Pre-load all instances
+    static constexpr float FOOTSTEP_VOLUME = 0.3f;
+    SoundId footstepSounds[MAX_FOOTSTEP_SOUNDS]; // Shared by every Player through SoundBank
     int currentFootstepIndex;
-    int currentInstanceIndex;
     float footstepTimer;
     float footstepInterval;
     float lastHorizontalSpeed;
@@ -57,6 +76,9 @@ public:
     void applyGravity(float deltaTime);
     void shoot();
     void reload();
+    void selectWeapon(uint8_t slot);    // Locally, no transaction
+    void switchWeapon(uint8_t slot);    // And on-chain, through SwitchWeapon
+    void updateWeapon(float deltaTime);
     void playFootstep();
     void updateFootsteps(float deltaTime);
     void takeDamage(float damage);
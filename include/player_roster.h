@@ -0,0 +1,58 @@
+#ifndef PLAYER_ROSTER_H
+#define PLAYER_ROSTER_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "account_mirror.h"
+
+// What the client knows about one player entity, assembled from its
+// component accounts
+struct RosterEntry {
+    char entity[AccountRecord::ADDRESS_SIZE];
+    char name[24];
+    bool local;
+    bool hasPosition;
+    uint8_t team;
+    bool alive;
+    uint32_t health;
+    uint32_t kills;
+    uint32_t deaths;
+    Vector3 position;       // As of the last Position update
+    Vector3 velocity;
+    float rotation;
+    float sinceUpdate;      // Seconds since the last Position update
+    bool hasWeapon;
+    uint32_t magazine[2];   // Primary and secondary ammo, as of the last Weapon update
+    uint32_t shotsFired[2]; // Rounds the Weapon updates show it spending, by slot - 1
+};
+
+// Every player in the account mirror, updated from its change notifications
+// rather than by reading accounts each frame. Remote players are drawn
+// dead-reckoned from their last known position and velocity.
+class PlayerRoster {
+public:
+    static const int MAX_PLAYERS = 16;
+
+    PlayerRoster();
+    ~PlayerRoster();
+    PlayerRoster(const PlayerRoster&) = delete;
+    PlayerRoster& operator=(const PlayerRoster&) = delete;
+
+    void update(float deltaTime);
+    void draw() const;
+
+    int count() const { return players; }
+    const RosterEntry& entry(int index) const { return entries[index]; }
+
+    // Extrapolated position, capped so a stalled feed doesn't send players through walls
+    Vector3 predictedPosition(const RosterEntry& entry) const;
+
+private:
+    static void onAccountChanged(const AccountRecord& record, void* user);
+    RosterEntry* entryFor(const char* entity);
+
+    RosterEntry entries[MAX_PLAYERS];
+    int players;
+};
+
+#endif // PLAYER_ROSTER_H
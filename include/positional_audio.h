@@ -0,0 +1,65 @@
+#ifndef POSITIONAL_AUDIO_H
+#define POSITIONAL_AUDIO_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "player_roster.h"
+#include "sound_bank.h"
+#include "weapons.h"
+
+struct PositionalAudioStats {
+    int audible;            // Remote players within AUDIBLE_RADIUS last tick
+    uint32_t played;
+    uint32_t culled;        // Shots too far away to ask for a voice
+};
+
+// Footsteps and gunshots of the other players in the roster, placed around
+// the listener. Once per tick every remote player's gain and pan are worked
+// out together; anyone past AUDIBLE_RADIUS is skipped before any sound is
+// looked at, so the cost follows the nearby players only. Gain falls off as
+// REFERENCE_DISTANCE / distance and fades to nothing at the radius. Pan is
+// where the source sits along the listener's right vector.
+// Shots come from magazine drops on each player's Weapon account (see
+// RosterEntry::shotsFired) and play the report of the LOADOUT weapon in the
+// slot that dropped; footsteps from the speed they are moving at.
+class PositionalAudio {
+public:
+    static constexpr float AUDIBLE_RADIUS = 40.0f;
+    static constexpr float REFERENCE_DISTANCE = 2.0f;   // Full volume inside this
+    static constexpr float PAN_WIDTH = 0.8f;            // Of the full left-right swing
+    static constexpr float FOOTSTEP_VOLUME = 0.3f;
+    static const int MAX_SHOTS_PER_TICK = 3;            // A burst seen in one update plays as a few shots
+    static const int SLOTS = 2;
+    static const int FOOTSTEP_SOUNDS = 9;
+
+    PositionalAudio();
+    ~PositionalAudio();
+    PositionalAudio(const PositionalAudio&) = delete;
+    PositionalAudio& operator=(const PositionalAudio&) = delete;
+
+    // `right` is the listener's right vector
+    void update(const PlayerRoster& roster, Vector3 listener, Vector3 right, float deltaTime);
+
+    const PositionalAudioStats& stats() const { return totals; }
+
+private:
+    static const int MAX_PLAYERS = PlayerRoster::MAX_PLAYERS;
+
+    // Per roster index; the roster only ever appends
+    float offsetX[MAX_PLAYERS];
+    float offsetY[MAX_PLAYERS];
+    float offsetZ[MAX_PLAYERS];
+    float gain[MAX_PLAYERS];
+    float pan[MAX_PLAYERS];
+    float stepTimer[MAX_PLAYERS];
+    uint32_t shotsHeard[MAX_PLAYERS][SLOTS];
+    int tracked;
+
+    SoundId footsteps[FOOTSTEP_SOUNDS];
+    SoundId gunshots[SLOTS];            // By slot - 1; equal where both weapons use one file
+    bool ownsGunshot[SLOTS];
+    int nextFootstep;
+    PositionalAudioStats totals;
+};
+
+#endif // POSITIONAL_AUDIO_H
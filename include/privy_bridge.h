@@ -2,73 +2,119 @@
 #define PRIVY_BRIDGE_H
 
 #include <string>
+#include <stdint.h>
+#include <string.h>
+
+// Buffer size for a Solana address (base58, at most 44 chars) plus NUL
+#define PRIVY_WALLET_ADDRESS_SIZE 64
+
+// Wallet state cached on the C++ side. JS writes it directly when the wallet
+// connects, disconnects, switches account or its balance changes, and bumps
+// `version`; the game loop only reads memory and never calls into JS.
+struct WalletState {
+    double balance;                            // Lamports
+    uint32_t version;                          // Incremented on every change
+    bool connected;
+    char address[PRIVY_WALLET_ADDRESS_SIZE];   // Empty when disconnected
+};
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 
 class PrivyBridge {
 public:
+    static const int WALLET_ADDRESS_SIZE = PRIVY_WALLET_ADDRESS_SIZE;
+    
     // Initialize the bridge - call this once at startup
     static void init() {
         EM_ASM({
-            // Initialize wallet state tracking
-            Module.privyWalletConnected = false;
-            Module.privyWalletAddress = "";
-            Module.privySolanaBalance = 0.0;
+            var statePtr = { balance: $0, version: $1, connected: $2, address: $3, addressSize: $4 };
+            var current = { connected: false, address: "", balance: 0.0 };
+            
+            function publish() {
+                HEAPF64[statePtr.balance >> 3] = current.balance;
+                HEAPU8[statePtr.connected] = current.connected ? 1 : 0;
+                stringToUTF8(current.address, statePtr.address, statePtr.addressSize);
+                HEAPU32[statePtr.version >> 2] = (HEAPU32[statePtr.version >> 2] + 1) >>> 0;
+            }
             
-            // Poll wallet status periodically
+            // Change callbacks: the page can also call these straight from
+            // Privy's own events; each is a no-op unless something changed
+            Module.privyWalletEvents = {
+                onConnect: function(address) {
+                    if (current.connected && current.address === (address || current.address)) return;
+                    current.connected = true;
+                    if (address) current.address = address;
+                    publish();
+                },
+                onDisconnect: function() {
+                    if (!current.connected && current.address === "") return;
+                    current.connected = false;
+                    current.address = "";
+                    current.balance = 0.0;
+                    publish();
+                },
+                onAccountChange: function(address) {
+                    if (!address || address === current.address) return;
+                    current.address = address;
+                    publish();
+                },
+                onBalanceChange: function(balance) {
+                    if (balance === null || balance === current.balance) return;
+                    current.balance = balance;
+                    publish();
+                }
+            };
+            var events = Module.privyWalletEvents;
+            
+            // Watch the Privy SDK in JS (off the game loop) and forward only changes
             setInterval(function() {
                 if (window.PrivyBridge && window.PrivyBridge.isWalletConnected) {
                     window.PrivyBridge.isWalletConnected().then(function(connected) {
-                        Module.privyWalletConnected = connected;
+                        if (!connected) {
+                            events.onDisconnect();
+                            return;
+                        }
+                        events.onConnect(null);
                         
-                        if (connected && window.PrivyBridge.getSolanaAddress) {
+                        if (window.PrivyBridge.getSolanaAddress) {
                             window.PrivyBridge.getSolanaAddress().then(function(address) {
-                                if (address) {
-                                    Module.privyWalletAddress = address;
-                                }
+                                events.onAccountChange(address);
+                            });
+                        }
+                        
+                        if (window.PrivyBridge.getSolanaBalance) {
+                            window.PrivyBridge.getSolanaBalance().then(function(balance) {
+                                events.onBalanceChange(balance);
                             });
-                            
-                            if (window.PrivyBridge.getSolanaBalance) {
-                                window.PrivyBridge.getSolanaBalance().then(function(balance) {
-                                    if (balance !== null) {
-                                        Module.privySolanaBalance = balance;
-                                    }
-                                });
-                            }
                         }
                     }).catch(function(err) {
                         console.error("Error checking wallet connection:", err);
                     });
                 }
             }, 1000); // Check every second
-        });
+        }, &state.balance, &state.version, &state.connected, state.address, WALLET_ADDRESS_SIZE);
+    }
+    
+    // Versioned read API: compare walletState().version with the last value
+    // seen to detect changes. Plain memory reads, safe every frame.
+    static const WalletState& walletState() {
+        return state;
     }
     
-    // Synchronous getters (safe to call from game loop)
     static bool isWalletConnected() {
-        return EM_ASM_INT({
-            return Module.privyWalletConnected || false;
-        });
+        return state.connected;
     }
     
-    static std::string getWalletAddress() {
-        char* result = (char*)EM_ASM_PTR({
-            var addr = Module.privyWalletAddress || "";
-            var len = lengthBytesUTF8(addr) + 1;
-            var ptr = _malloc(len);
-            stringToUTF8(addr, ptr, len);
-            return ptr;
-        });
-        std::string addr(result);
-        free(result);
-        return addr;
+    // Copies the cached address into a caller-owned buffer; always NUL-terminated
+    static void getWalletAddress(char* buffer, int bufferSize) {
+        if (bufferSize <= 0) return;
+        strncpy(buffer, state.address, bufferSize - 1);
+        buffer[bufferSize - 1] = '\0';
     }
     
     static double getSolanaBalance() {
-        return EM_ASM_DOUBLE({
-            return Module.privySolanaBalance || 0.0;
-        });
+        return state.balance;
     }
     
     // Async actions (non-blocking)
@@ -78,7 +124,7 @@ public:
                 window.PrivyBridge.connectWallet()
                     .then(function() {
                         console.log("Wallet connected successfully");
-                        Module.privyWalletConnected = true;
+                        Module.privyWalletEvents.onConnect(null);
                     })
                     .catch(function(err) {
                         console.error("Failed to connect wallet:", err);
@@ -95,9 +141,7 @@ public:
                 window.PrivyBridge.disconnectWallet()
                     .then(function() {
                         console.log("Wallet disconnected successfully");
-                        Module.privyWalletConnected = false;
-                        Module.privyWalletAddress = "";
-                        Module.privySolanaBalance = 0.0;
+                        Module.privyWalletEvents.onDisconnect();
                     })
                     .catch(function(err) {
                         console.error("Failed to disconnect wallet:", err);
@@ -217,15 +261,21 @@ public:
             return 0;
         });
     }
+    
+private:
+    static inline WalletState state = {};
 };
 
 #else
 // Stub implementation for desktop builds
 class PrivyBridge {
 public:
+    static const int WALLET_ADDRESS_SIZE = PRIVY_WALLET_ADDRESS_SIZE;
+    
     static void init() {}
+    static const WalletState& walletState() { static const WalletState disconnected = {}; return disconnected; }
     static bool isWalletConnected() { return false; }
-    static std::string getWalletAddress() { return ""; }
+    static void getWalletAddress(char* buffer, int bufferSize) { if (bufferSize > 0) buffer[0] = '\0'; }
     static double getSolanaBalance() { return 0.0; }
     static void requestConnectWallet() {}
     static void requestDisconnectWallet() {}
@@ -0,0 +1,77 @@
+#ifndef PROJECTILES_H
+#define PROJECTILES_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "collision_grid.h"
+#include "hitboxes.h"
+#include "job_system.h"
+
+// Where a projectile ended up this step
+struct ProjectileHit {
+    HitRegion region;       // HIT_WALL for the map (ground included), else the part of a player
+    int player;             // Hitboxes id; -1 for the map
+    uint8_t weaponSlot;     // As spawned: 1 = primary, 2 = secondary
+    float distance;         // Travelled since it was fired
+    Vector3 point;
+};
+
+// Shots that take time to arrive: each projectile falls under its own
+// gravity and is swept, one tick's segment at a time, against the map (through
+// a CollisionGrid) and the players' Hitboxes. State is kept as flat arrays and
+// integrated in ranges on the JobSystem; a dependent job then removes
+// the projectiles that hit something or ran out of time and lists the hits,
+// so thousands in flight cost a few microseconds of main-thread time.
+class Projectiles {
+public:
+    static const int MAX_PROJECTILES = 4096;    // Spawns beyond this are dropped
+    static const int GRAIN = 256;               // Fewer than this integrate in one job
+    static constexpr float MAX_LIFETIME = 5.0f;
+
+    Projectiles();
+
+    // False when full. Nothing may spawn while a step is in flight.
+    bool spawn(Vector3 position, Vector3 velocity, float gravity, uint8_t weaponSlot);
+
+    // Starts step() as jobs, counted on `done`. `grid` and `targets` (may be
+    // null) must stay unchanged, and the projectiles untouched, until it is done.
+    void beginStep(float deltaTime, const CollisionGrid& grid, const Hitboxes* targets, JobCounter& done);
+    void step(float deltaTime, const CollisionGrid& grid, const Hitboxes* targets);
+
+    // What the last step's finished projectiles hit
+    int hitCount() const { return hits; }
+    const ProjectileHit& hit(int index) const { return hitList[index]; }
+
+    int count() const { return live; }
+    void draw() const;
+    void clear();
+
+private:
+    static void integrate(void* data, int begin, int end);
+    static void removeFinished(void* data, int begin, int end);
+
+    float posX[MAX_PROJECTILES];
+    float posY[MAX_PROJECTILES];
+    float posZ[MAX_PROJECTILES];
+    float velX[MAX_PROJECTILES];
+    float velY[MAX_PROJECTILES];
+    float velZ[MAX_PROJECTILES];
+    float gravity[MAX_PROJECTILES];
+    float age[MAX_PROJECTILES];
+    float travelled[MAX_PROJECTILES];
+    uint8_t slot[MAX_PROJECTILES];
+    HitRegion struck[MAX_PROJECTILES];  // Set by the step that ends it; HIT_NONE while flying
+    int struckPlayer[MAX_PROJECTILES];
+    int live;
+
+    ProjectileHit hitList[MAX_PROJECTILES];
+    int hits;
+
+    // The step in flight
+    float stepTime;
+    const CollisionGrid* stepGrid;
+    const Hitboxes* stepTargets;
+    JobCounter integrated;
+};
+
+#endif // PROJECTILES_H
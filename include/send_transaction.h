@@ -0,0 +1,32 @@
+#ifndef SEND_TRANSACTION_H
+#define SEND_TRANSACTION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "native_bridge.h"
+#include "bridge_mailbox.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*SendTransactionCallback)(bool success, const char* error);
+
+// Sign and submit a complete message built by TxTemplates. The bytes are
+// copied before returning, so the caller may reuse the buffer.
+static inline void SendPreparedTransaction(const uint8_t* message, uint32_t size, SendTransactionCallback callback) {
+#ifdef PLATFORM_WEB
+    BridgeMailboxSubmitMessage(message, size, callback);
+#else
+    (void)message;
+    (void)size;
+    callback(false, "Web platform only");
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SEND_TRANSACTION_H
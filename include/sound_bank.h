@@ -0,0 +1,86 @@
+#ifndef SOUND_BANK_H
+#define SOUND_BANK_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "asset_pack.h"
+
+// 0 = no sound (missing file or bank full); playing it does nothing
+typedef uint16_t SoundId;
+
+struct SoundBankStats {
+    int loaded;             // Distinct sounds decoded and resident
+    int loading;            // Still decoding, or waiting for the audio device
+    int references;         // Handles held across all entities
+    uint32_t decodes;       // Files decoded since startup
+};
+
+// Every sound effect, decoded once per process and shared. acquire() by
+// path loads the file the first time and otherwise just counts another
+// reference; the last release() unloads it. Each sound carries a fixed set
+// of aliases (its overlapping instances, which VoiceManager hands voices
+// to), created with the sound and shared by everyone holding it, so a match
+// full of players costs one set of samples and aliases per sound.
+//
+// Decoding runs on the AssetLoader, so acquire() returns at once and the
+// sound stays silent until update() has turned the decoded samples into a
+// playable sound. `critical` sounds hold the loading screen until then.
+// Files come from the AssetPack when one is open (a sound in a pack that
+// is still downloading waits for it), otherwise from disk.
+class SoundBank {
+public:
+    static const int MAX_SOUNDS = 32;
+    static const int MAX_INSTANCES = 8;
+    static const int PATH_SIZE = 128;
+
+    static SoundBank& instance();
+
+    // `instances` and `critical` apply when this call loads the sound
+    SoundId acquire(const char* path, int instances, bool critical = false);
+    void release(SoundId id);
+
+    // Main thread, once per frame, once the audio device is open: creates
+    // the sounds whose decoding finished
+    void update();
+
+    // Null with count 0 for an unknown id or a sound still loading
+    const Sound* instances(SoundId id, int& count) const;
+    bool ready(SoundId id) const;
+    const SoundBankStats& stats() const { return totals; }
+
+private:
+    enum EntryState : uint8_t {
+        ENTRY_FREE = 0,
+        ENTRY_WAITING,      // For its pack file to arrive
+        ENTRY_DECODING,     // On a loader thread
+        ENTRY_DECODED,      // Samples in `wave`, waiting for update()
+        ENTRY_READY,
+        ENTRY_FAILED
+    };
+
+    struct Entry {
+        EntryState state;
+        char path[PATH_SIZE];
+        const AssetPackEntry* packed;   // Null: loose file at `path`
+        bool critical;
+        int references;     // May reach 0 while loading; update() frees it after
+        Wave wave;
+        Sound sound;
+        Sound aliases[MAX_INSTANCES];
+        int aliasCount;
+    };
+
+    SoundBank();
+    SoundBank(const SoundBank&) = delete;
+    SoundBank& operator=(const SoundBank&) = delete;
+
+    static void decode(void* user);     // Loader thread
+    static void decoded(void* user);    // Main thread
+    void startDecode(Entry& entry);
+    void unload(Entry& entry);
+
+    Entry entries[MAX_SOUNDS];
+    SoundBankStats totals;
+};
+
+#endif // SOUND_BANK_H
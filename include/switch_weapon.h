@@ -4,9 +4,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-#ifdef PLATFORM_WEB
-#include <emscripten.h>
-#endif
+#include "native_bridge.h"
+#include "bridge_mailbox.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,32 +15,13 @@ typedef void (*SwitchWeaponCallback)(bool success, const char* error);
 
 // Switch to weapon slot (1=primary, 2=secondary)
 static inline void SwitchWeapon(uint8_t weaponSlot, SwitchWeaponCallback callback) {
+    BridgeRequest request = { 0 };
+    request.instruction = BRIDGE_SWITCH_WEAPON;
+    request.weaponSlot = weaponSlot;
 #ifdef PLATFORM_WEB
-    EM_ASM({
-        const weaponSlot = $0;
-        const callback = $1;
-        
-        if (!window.SolanaGameBridge) {
-            const errorMsg = "SolanaGameBridge not initialized";
-            const errorPtr = allocateUTF8(errorMsg);
-            Module.dynCall_vii(callback, 0, errorPtr);
-            _free(errorPtr);
-            return;
-        }
-        
-        window.SolanaGameBridge.switchWeapon(weaponSlot)
-            .then(() => {
-                Module.dynCall_vii(callback, 1, 0);
-            })
-            .catch(err => {
-                const errorMsg = err.message || "Switch weapon failed";
-                const errorPtr = allocateUTF8(errorMsg);
-                Module.dynCall_vii(callback, 0, errorPtr);
-                _free(errorPtr);
-            });
-    }, weaponSlot, callback);
+    BridgeMailboxSubmit(&request, callback);
 #else
-    callback(false, "Web platform only");
+    NativeBridgeSubmit(&request, callback);
 #endif
 }
 
@@ -0,0 +1,42 @@
+#ifndef TIMEDEMO_H
+#define TIMEDEMO_H
+
+#include <raylib.h>
+
+// Camera keyframe on the timedemo path (yaw/pitch in radians, like Player)
+struct TimedemoKeyframe {
+    float time;
+    Vector3 position;
+    float yaw;
+    float pitch;
+};
+
+// Time window in which the demo holds the trigger
+struct TimedemoBurst {
+    float start;
+    float end;
+};
+
+// Deterministic flythrough of the cyberpunk arena for render benchmarking.
+// Simulation runs at a fixed 60 Hz step regardless of how long frames take,
+// so every run draws exactly the same frames; only the wall-clock cost of
+// each frame is measured. Past the scripted camera and trigger each frame
+// is the game's own (Game::step, drawScene, drawHUD), played natively
+// against the mock chain with its clock on demo time.
+class Timedemo {
+public:
+    static const int RENDER_WIDTH = 1280;
+    static const int RENDER_HEIGHT = 720;
+    static const int WARMUP_FRAMES = 30;
+
+    // Returns true if argv asks for the timedemo (--timedemo)
+    static bool requested(int argc, char** argv);
+
+    // Runs the demo in its own hidden window and prints frame time stats.
+    // Options: --timedemo-csv <path> writes per-frame times in ms.
+    // Returns the process exit code, which is non-zero if any frame after
+    // warmup made a heap allocation (counted in ALLOC_TRACKING builds only).
+    static int run(int argc, char** argv);
+};
+
+#endif // TIMEDEMO_H
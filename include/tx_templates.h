@@ -0,0 +1,124 @@
+#ifndef TX_TEMPLATES_H
+#define TX_TEMPLATES_H
+
+#include <stdint.h>
+#include "execute_batch.h"
+
+// Accounts the gameplay instructions reference
+enum TxAccount : uint8_t {
+    TX_ACCOUNT_AUTHORITY = 0,   // Wallet; signs and pays
+    TX_ACCOUNT_PLAYER,
+    TX_ACCOUNT_WEAPON,
+    TX_ACCOUNT_POSITION,
+    TX_ACCOUNT_HEALTH,
+    TX_ACCOUNT_PLAYER_STATS,
+    TX_ACCOUNT_GAME,
+    TX_ACCOUNT_WORLD,           // World the entity lives in; not a component
+    TX_ACCOUNT_VICTIM,          // Apply damage only, resolved per call
+    TX_ACCOUNT_VICTIM_HEALTH,
+    TX_ACCOUNT_VICTIM_STATS,
+    TX_ACCOUNT_COUNT
+};
+
+// Solana transaction messages for the gameplay instructions (movement,
+// shoot, reload, switch weapon, apply damage), laid out once per session
+// from the IDL: account keys, programs and the compute budget are fixed up
+// front, so sending only rewrites the arguments and the recent blockhash.
+// The bridge signs and submits the bytes as they are
+// (SendPreparedTransaction) instead of rebuilding the instruction in JS.
+//
+// Each gameplay instruction is the Bolt World program's apply, as the
+// bridge's ApplySystem calls send it. Its accounts are the world, the
+// system, then a (component program, component) pair for every component
+// the system takes, in the system IDL's order, and the authority last.
+// Only the components the system changes are writable. Its data is the
+// apply discriminator followed by a Borsh `bytes` holding the JSON of the
+// arguments the bridge calls take:
+//   movement:      {"x","y","z","rotation","velocity_x","velocity_y","velocity_z"}
+//   shoot/reload/switch weapon: {"weapon_slot"}
+//   apply damage:  {"weapon_type","is_headshot","distance"}
+//
+// connect() only fetches the session in TX_TEMPLATES builds (see the
+// README); elsewhere build() returns null and the per-instruction bridge
+// calls are used.
+class TxTemplates {
+public:
+    static const int KEY_SIZE = 32;
+    static const int ADDRESS_SIZE = 48;
+    static const int MAX_MESSAGE_SIZE = 1232 - 65;     // Packet size minus one signature
+    static const int MAX_INSTRUCTIONS = 8;
+    static const int MAX_KEYS = 32;
+    static const int MAX_COMPONENTS = 8;               // Per system
+    static const int MAX_ARGS_SIZE = 256;              // JSON text of one instruction's arguments
+    static const int VICTIM_CACHE_SIZE = 8;
+    static const uint32_t DEFAULT_UNIT_LIMIT = 50000;  // Compute units per gameplay instruction
+    static constexpr double BLOCKHASH_LIFETIME = 60.0; // Seconds; the cluster keeps ~150 slots
+
+    static TxTemplates& instance();
+
+    // Web TX_TEMPLATES builds: fetch the session's accounts from
+    // SolanaGameBridge, prepare, and keep the blockhash fresh. No-op if the
+    // bridge can't send prepared messages, and in every other build.
+    void connect();
+    void reset();
+
+    bool setAccount(TxAccount account, const char* base58);
+    void setAccountKey(TxAccount account, const uint8_t* key);
+    void setComputeBudget(uint32_t unitsPerInstruction, uint64_t microLamportsPerUnit);
+    bool setBlockhash(const char* base58);
+    void setBlockhashKey(const uint8_t* hash);
+
+    // Lays out every template; needs all the session accounts
+    bool prepare();
+    bool ready() const;
+
+    // Message sending `actions` as one transaction, valid until the next call.
+    // Null if not ready, the blockhash is stale or a victim's accounts aren't
+    // in the account mirror yet; callers then use the regular bridge calls.
+    const uint8_t* build(const BatchAction* actions, int count, uint32_t* size);
+
+    static bool decodeBase58(const char* text, uint8_t* out, int size);
+
+private:
+    struct Template {
+        uint8_t message[MAX_MESSAGE_SIZE];
+        uint32_t size;
+        uint16_t blockhashOffset;
+        uint16_t dataLengthOffset;    // Compact-u16 length of the apply's data
+        uint16_t argOffset;           // JSON text; runs to the end of the message
+        int16_t victimKeyOffset[3];   // Victim, victim health, victim stats
+    };
+
+    struct Victim {
+        char address[ADDRESS_SIZE];
+        uint8_t keys[3][KEY_SIZE];
+        uint32_t lastUsed;
+    };
+
+    TxTemplates();
+    const uint8_t* victimKeys(const char* address);
+    uint32_t compile(const BatchAction* actions, int count, uint8_t* out, Template* layout);
+
+    uint8_t sessionKeys[TX_ACCOUNT_COUNT][KEY_SIZE];
+    bool known[TX_ACCOUNT_COUNT];
+    uint8_t systemKeys[BATCH_ACTION_APPLY_DAMAGE + 1][KEY_SIZE];
+    uint8_t componentProgramKeys[TX_ACCOUNT_COUNT][KEY_SIZE];
+    uint8_t worldProgramKey[KEY_SIZE];
+    uint8_t computeBudgetKey[KEY_SIZE];
+    TxAccount components[BATCH_ACTION_APPLY_DAMAGE + 1][MAX_COMPONENTS];
+    int componentCount[BATCH_ACTION_APPLY_DAMAGE + 1];
+    uint32_t unitsPerInstruction;
+    uint64_t unitPrice;
+
+    uint8_t blockhash[KEY_SIZE];
+    double blockhashTime;
+    bool hasBlockhash;
+    bool prepared;
+
+    Template templates[BATCH_ACTION_APPLY_DAMAGE + 1];
+    uint8_t scratch[MAX_MESSAGE_SIZE];
+    Victim victims[VICTIM_CACHE_SIZE];
+    uint32_t victimClock;
+};
+
+#endif // TX_TEMPLATES_H
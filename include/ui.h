@@ -2,16 +2,26 @@
 #define UI_H
 
 #include <raylib.h>
-#include <string>
+#include "action_queue.h"
+#include "bridge_events.h"
+#include "bridge_latency.h"
+#include "movement_sync.h"
+#include "player_roster.h"
+#include "weapon_prediction.h"
 
 class UI {
 public:
     static void drawCrosshair(int screenWidth, int screenHeight);
-    static void drawGunHUD(int ammo, int maxAmmo, int screenWidth, int screenHeight);
-    static void drawWalletInfo(bool connected, const std::string& address, double balance);
+    static void drawGunHUD(const char* weaponName, int ammo, int maxAmmo, int screenWidth, int screenHeight);
+    static void drawWalletInfo(bool connected, const char* address, double balance);
     static void drawHealthBar(float health, float maxHealth, int screenWidth, int screenHeight);
     static void drawControls();
     static void drawReticle(int screenWidth, int screenHeight, bool shooting);
+    static void drawNetworkStats(const ActionQueueStats& stats, const MovementSyncStats& movement,
+                                 const WeaponPrediction& weapon, const BridgeEventStats& events, int screenWidth);
+    static void drawScoreboard(const PlayerRoster& roster, int screenWidth, int screenHeight);
+    static void drawBridgeLatency(const BridgeLatency& latency, int screenWidth, int screenHeight);
+    static void drawLoadingScreen(float progress, const char* pending, int screenWidth, int screenHeight);
 };
 
 #endif // UI_H
@@ -0,0 +1,71 @@
+#ifndef VOICE_MANAGER_H
+#define VOICE_MANAGER_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "sound_bank.h"
+
+// Higher plays over lower when voices run out
+enum VoicePriority : uint8_t {
+    VOICE_PRIORITY_LOW = 0,
+    VOICE_PRIORITY_FOOTSTEP = 1,
+    VOICE_PRIORITY_GUNSHOT = 2
+};
+
+struct VoiceStats {
+    int active;             // Voices playing after the last update()
+    int peak;
+    uint32_t played;
+    uint32_t stolen;        // Voices cut short for a more important sound
+    uint32_t rejected;      // Requests that lost to every playing voice
+    uint32_t culled;        // Too quiet to be worth a voice
+};
+
+// Every sound effect plays through here, so the number of sounds raylib
+// mixes at once never exceeds MAX_VOICES however many players are firing.
+// A sound comes with aliases, its possible overlapping instances (see
+// SoundBank), and a free alias gets the voice.
+// - When every voice is busy, the lowest-priority voice is stolen, the
+//   quietest of those, then the oldest. A request that ranks below all of
+//   them is dropped instead.
+// - A sound quieter than AUDIBLE_VOLUME isn't started at all.
+class VoiceManager {
+public:
+    static const int MAX_VOICES = 16;
+    static constexpr float AUDIBLE_VOLUME = 0.01f;
+
+    static VoiceManager& instance();
+
+    // `pan` is raylib's: 0.5 is centred. Returns false if the sound was
+    // culled or lost to the playing voices.
+    bool play(const Sound* aliases, int aliasCount, VoicePriority priority, float volume, float pan = 0.5f);
+    bool play(SoundId sound, VoicePriority priority, float volume, float pan = 0.5f);
+
+    // Frees the voices of sounds that finished. Call once per frame.
+    void update();
+
+    // Stops everything that uses these aliases, before they are unloaded
+    void release(const Sound* aliases, int aliasCount);
+
+    const VoiceStats& stats() const { return totals; }
+
+private:
+    struct Voice {
+        bool active;
+        Sound sound;
+        VoicePriority priority;
+        float volume;
+        uint32_t startedAt;     // Play order
+    };
+
+    VoiceManager();
+    int findVoice(const Sound& sound) const;
+    int pickVictim() const;
+    void start(int index, const Sound& sound, VoicePriority priority, float volume, float pan);
+
+    Voice voices[MAX_VOICES];
+    uint32_t playCount;
+    VoiceStats totals;
+};
+
+#endif // VOICE_MANAGER_H
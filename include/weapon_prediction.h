@@ -0,0 +1,87 @@
+#ifndef WEAPON_PREDICTION_H
+#define WEAPON_PREDICTION_H
+
+#include <stdint.h>
+#include "action_queue.h"
+#include "account_mirror.h"
+
+struct WeaponPredictionStats {
+    uint32_t predicted;     // Shots and reloads applied ahead of the chain
+    uint32_t confirmed;
+    uint32_t rolledBack;    // Failed or cancelled; their effect was undone
+    uint32_t corrections;   // Weapon account updates that changed what the player saw
+};
+
+// Ammo as the player sees it: the local player's last Weapon account plus
+// every shoot and reload the chain hasn't ruled on yet, replayed in order.
+// - Shooting and reloading change the prediction at once and enqueue the
+//   matching action, remembering its id.
+// - A failed action is dropped and the rest replayed, which rolls it back.
+// - A Weapon update retires the oldest actions it already reflects,
+//   confirmed or not, since updates and confirmations arrive in either
+//   order. A confirmed action no update accounts for goes after
+//   CONFIRM_TIMEOUT.
+// - Without a Weapon account (offline, or the bridge has no account feed)
+//   the local state is the authority and actions fold into it.
+// Slots are the contract's: 1 = primary, 2 = secondary.
+class WeaponPrediction {
+public:
+    static const int SLOTS = 2;
+    static const int MAX_PENDING = ActionQueue::CAPACITY + ActionQueue::MAX_IN_FLIGHT * ActionQueue::MAX_BATCH;
+    static const int DEFAULT_RESERVE = 9000;    // Until the chain says otherwise
+    static constexpr float CONFIRM_TIMEOUT = 2.0f;
+
+    WeaponPrediction(int primaryMagazine, int secondaryMagazine);
+    ~WeaponPrediction();
+    WeaponPrediction(const WeaponPrediction&) = delete;
+    WeaponPrediction& operator=(const WeaponPrediction&) = delete;
+
+    // Each returns false, changing nothing, if the predicted state doesn't
+    // allow it (empty magazine; full magazine or no reserve)
+    bool shoot(uint8_t slot);
+    bool reload(uint8_t slot);
+
+    // Expires confirmations the account feed never echoed. Call once per frame.
+    void update(float deltaTime);
+
+    int ammo(uint8_t slot) const;
+    int reserve(uint8_t slot) const;
+    int magazine(uint8_t slot) const;
+    int pending() const { return pendingActions; }
+    bool hasAuthority() const { return authority; }
+    const WeaponPredictionStats& stats() const { return totals; }
+
+private:
+    struct WeaponState {
+        int ammo[SLOTS];
+        int reserve[SLOTS];
+    };
+
+    struct PendingAction {
+        ActionId id;
+        uint8_t type;
+        uint8_t slot;
+        bool confirmed;
+        uint64_t confirmedAfter;    // Newest Weapon slot seen when it was confirmed
+        float confirmedAge;
+    };
+
+    bool predict(uint8_t type, uint8_t slot);
+    bool apply(WeaponState& state, uint8_t type, uint8_t slot) const;
+    void remove(int index);
+    void replay();
+
+    static void onResult(ActionId id, uint8_t type, bool success, const char* error, void* user);
+    static void onWeaponChanged(const AccountRecord& record, void* user);
+
+    int capacity[SLOTS];
+    WeaponState base;           // Authoritative, or local when there is no authority
+    WeaponState predicted;
+    PendingAction actions[MAX_PENDING];
+    int pendingActions;
+    bool authority;
+    uint64_t authoritySlot;
+    WeaponPredictionStats totals;
+};
+
+#endif // WEAPON_PREDICTION_H
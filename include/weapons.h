@@ -0,0 +1,112 @@
+#ifndef WEAPONS_H
+#define WEAPONS_H
+
+#include <raylib.h>
+#include <stdint.h>
+
+class Player;
+class Gun;
+class Effects;
+class Projectiles;
+class Map;
+class Hitboxes;
+class PlayerRoster;
+
+// How a weapon's shots reach what they hit. Chooses its fire code at
+// compile time, so no shot ever branches on it.
+enum WeaponArchetype : uint8_t {
+    ARCHETYPE_HITSCAN = 0,      // An instant ray out to the weapon's range
+    ARCHETYPE_PROJECTILE        // A Projectiles entry that flies and drops
+};
+
+enum WeaponId : uint8_t {
+    WEAPON_SMG = 0,
+    WEAPON_LAUNCHER,
+    WEAPON_COUNT
+};
+
+static const int RECOIL_STEPS = 6;
+
+// View kick for each shot of a burst, radians; past the last step it repeats
+struct RecoilPattern {
+    float pitch[RECOIL_STEPS];
+    float yaw[RECOIL_STEPS];
+    float gunKick;          // Gun::recoilAngle on each shot, degrees
+    float resetTime;        // Seconds without firing before a burst starts over
+};
+
+struct EffectProfile {
+    const char* sound;
+    float volume;
+    float flashScale;       // Muzzle flash and light size; 1 is the SMG's
+    bool tracer;            // Hitscan only: a tracer to whatever was hit
+};
+
+struct WeaponDef {
+    const char* name;
+    uint8_t slot;                   // The contract's: 1 = primary, 2 = secondary
+    WeaponArchetype archetype;
+    int damage;                     // Per hit, as the contract starts it; headshots double it
+    int roundsPerMinute;
+    int magazine;
+    float reloadTime;               // Seconds before it fires again after a reload
+    float spread;                   // Half-angle of the cone shots leave in, radians
+    float range;                    // Hitscan reach; projectiles fly until they land
+    float muzzleSpeed;              // Projectiles only
+    float gravity;                  // Projectiles only
+    RecoilPattern recoil;
+    EffectProfile effect;
+
+    constexpr float cooldown() const { return 60.0f / roundsPerMinute; }
+};
+
+// Every weapon, by WeaponId. Adding one is a row here (and a LOADOUT
+// entry to carry it); the fire code for it is generated from the row.
+constexpr WeaponDef WEAPONS[WEAPON_COUNT] = {
+    {
+        "SMG", 1, ARCHETYPE_HITSCAN,
+        25, 600, 30, 1.2f, 0.004f, 300.0f, 0.0f, 0.0f,
+        { { 0.004f, 0.005f, 0.006f, 0.006f, 0.007f, 0.007f },
+          { 0.001f, -0.002f, 0.002f, -0.003f, 0.003f, -0.002f }, 2.5f, 0.25f },
+        { "assets/gun/audio/submachinegun-gunshot.mp3", 0.5f, 1.0f, true }
+    },
+    {
+        "LAUNCHER", 2, ARCHETYPE_PROJECTILE,
+        15, 120, 12, 2.0f, 0.0f, 0.0f, 60.0f, 9.8f,
+        { { 0.03f, 0.03f, 0.03f, 0.03f, 0.03f, 0.03f },
+          { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, 4.0f, 0.6f },
+        // Shares the SMG's report on purpose until it has a sound of its own;
+        // Gun acquires each distinct file once
+        { "assets/gun/audio/submachinegun-gunshot.mp3", 0.6f, 1.6f, false }
+    }
+};
+
+// What each contract slot carries, by slot - 1
+constexpr WeaponId LOADOUT[2] = { WEAPON_SMG, WEAPON_LAUNCHER };
+
+static_assert(WEAPONS[LOADOUT[0]].slot == 1 && WEAPONS[LOADOUT[1]].slot == 2, "LOADOUT weapons must match their slots");
+
+// Everything one shot can touch. Only `roster` may be null, and then
+// `targets` must be empty.
+struct ShotContext {
+    Player* player;
+    Gun* gun;
+    Effects* effects;
+    Projectiles* projectiles;
+    const Map* map;
+    const Hitboxes* targets;
+    const PlayerRoster* roster;     // What targets' ids index
+    Vector3 muzzle;
+    Vector3 forward;                // Where the player aims, normalized
+};
+
+// Fires one shot: predicts it (ammo, cooldown, on-chain Shoot), kicks the
+// view and the gun, then sends the shot. Returns at once if the magazine
+// is empty.
+typedef void (*FireFunction)(ShotContext& shot);
+
+// The fire code compiled for `weapon`. Look it up when the weapon is
+// equipped, not per shot.
+FireFunction fireFunction(WeaponId weapon);
+
+#endif // WEAPONS_H
@@ -0,0 +1,226 @@
+#include "account_mirror.h"
+#include <cstddef>
+#include <cstring>
+
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+#else
+    #include "native_bridge.h"
+    #include "mock_chain.h"
+#endif
+
+static const int INDEX_SIZE = AccountMirror::MAX_ACCOUNTS * 2;
+
+static uint32_t hashAddress(const char* address) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (const char* c = address; *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+    return hash;
+}
+
+static void copyAddress(char* out, const char* address) {
+    out[0] = '\0';
+    if (!address) return;
+    strncpy(out, address, AccountRecord::ADDRESS_SIZE - 1);
+    out[AccountRecord::ADDRESS_SIZE - 1] = '\0';
+}
+
+AccountMirror& AccountMirror::instance() {
+    static AccountMirror mirror;
+    return mirror;
+}
+
+AccountMirror::AccountMirror() {
+    listenerCount = 0;
+    localEntity[0] = '\0';
+    clear();
+}
+
+void AccountMirror::clear() {
+    records = 0;
+    changedCount = 0;
+    for (int i = 0; i < INDEX_SIZE; i++) index[i] = -1;
+    memset(&totals, 0, sizeof(totals));
+}
+
+AccountKind AccountMirror::kindOf(const uint8_t* data, size_t size) {
+    if (!data || size < bolt::DISCRIMINATOR_SIZE) return ACCOUNT_UNKNOWN;
+    if (memcmp(data, bolt::Position::DISCRIMINATOR, bolt::DISCRIMINATOR_SIZE) == 0) return ACCOUNT_POSITION;
+    if (memcmp(data, bolt::Health::DISCRIMINATOR, bolt::DISCRIMINATOR_SIZE) == 0) return ACCOUNT_HEALTH;
+    if (memcmp(data, bolt::Weapon::DISCRIMINATOR, bolt::DISCRIMINATOR_SIZE) == 0) return ACCOUNT_WEAPON;
+    if (memcmp(data, bolt::Player::DISCRIMINATOR, bolt::DISCRIMINATOR_SIZE) == 0) return ACCOUNT_PLAYER;
+    if (memcmp(data, bolt::PlayerStats::DISCRIMINATOR, bolt::DISCRIMINATOR_SIZE) == 0) return ACCOUNT_PLAYER_STATS;
+    if (memcmp(data, bolt::Game::DISCRIMINATOR, bolt::DISCRIMINATOR_SIZE) == 0) return ACCOUNT_GAME;
+    return ACCOUNT_UNKNOWN;
+}
+
+// Index slot holding `address`, or the empty slot where it would go
+int AccountMirror::slotFor(const char* address) const {
+    int slot = (int)(hashAddress(address) & (INDEX_SIZE - 1));
+    while (index[slot] >= 0 && strcmp(accounts[index[slot]].address, address) != 0) {
+        slot = (slot + 1) & (INDEX_SIZE - 1);
+    }
+    return slot;
+}
+
+const AccountRecord* AccountMirror::find(const char* address) const {
+    if (!address) return nullptr;
+    int slot = slotFor(address);
+    return index[slot] >= 0 ? &accounts[index[slot]] : nullptr;
+}
+
+const AccountRecord* AccountMirror::findComponent(const char* entity, AccountKind kind) const {
+    if (!entity || !*entity) return nullptr;
+    for (int i = 0; i < records; i++) {
+        if (accounts[i].kind == kind && strcmp(accounts[i].entity, entity) == 0) return &accounts[i];
+    }
+    return nullptr;
+}
+
+bool AccountMirror::apply(const char* address, const char* entity, uint64_t slot, const uint8_t* data, size_t size) {
+    if (!address || !*address || size > AccountRecord::MAX_DATA_SIZE) {
+        totals.rejected++;
+        return false;
+    }
+
+    int indexSlot = slotFor(address);
+    AccountRecord* record;
+    if (index[indexSlot] >= 0) {
+        record = &accounts[index[indexSlot]];
+        if (slot < record->slot) {
+            totals.stale++;
+            return false;
+        }
+        if (slot == record->slot) {
+            totals.duplicate++;
+            return false;
+        }
+    } else {
+        if (records == MAX_ACCOUNTS) {
+            totals.rejected++;
+            return false;
+        }
+        index[indexSlot] = (int16_t)records;
+        record = &accounts[records++];
+        copyAddress(record->address, address);
+        record->entity[0] = '\0';
+        record->notifyPending = false;
+    }
+
+    if (entity && *entity) copyAddress(record->entity, entity);
+    record->kind = kindOf(data, size);
+    record->slot = slot;
+    record->size = (uint32_t)size;
+    memcpy(record->data, data, size);
+    totals.applied++;
+
+    if (!record->notifyPending) {
+        record->notifyPending = true;
+        changed[changedCount++] = (int)(record - accounts);
+    }
+    return true;
+}
+
+void AccountMirror::setLocalEntity(const char* entity) {
+    copyAddress(localEntity, entity);
+}
+
+bool AccountMirror::isLocalEntity(const char* entity) const {
+    return entity && localEntity[0] && strcmp(entity, localEntity) == 0;
+}
+
+bool AccountMirror::subscribe(AccountKind kind, AccountListener listener, void* user) {
+    if (listenerCount == MAX_LISTENERS) return false;
+    listeners[listenerCount++] = (Listener){ kind, listener, user };
+    return true;
+}
+
+void AccountMirror::unsubscribe(AccountListener listener, void* user) {
+    for (int i = 0; i < listenerCount; i++) {
+        if (listeners[i].callback == listener && listeners[i].user == user) {
+            listeners[i] = listeners[--listenerCount];
+            i--;
+        }
+    }
+}
+
+void AccountMirror::dispatch() {
+    // Listeners may read any record, so every change is applied before the first notification
+    for (int i = 0; i < changedCount; i++) {
+        AccountRecord& record = accounts[changed[i]];
+        record.notifyPending = false;
+        for (int j = 0; j < listenerCount; j++) {
+            if (listeners[j].kind == ACCOUNT_UNKNOWN || listeners[j].kind == record.kind) {
+                listeners[j].callback(record, listeners[j].user);
+            }
+        }
+    }
+    changedCount = 0;
+}
+
+#if defined(PLATFORM_WEB)
+
+// Where JS copies each update, so the feed never allocates on the wasm heap.
+// Data too large to fit is not copied; its size alone gets it rejected.
+struct FeedStaging {
+    char address[AccountRecord::ADDRESS_SIZE];
+    char entity[AccountRecord::ADDRESS_SIZE];
+    uint8_t data[AccountRecord::MAX_DATA_SIZE];
+};
+
+static FeedStaging staging;
+
+// Called from JS once an update is in `staging`
+extern "C" EMSCRIPTEN_KEEPALIVE void AccountMirrorPush(double slot, int size) {
+    AccountMirror::instance().apply(staging.address, staging.entity, (uint64_t)slot, staging.data,
+                                    size < 0 ? 0 : (size_t)size);
+}
+
+extern "C" EMSCRIPTEN_KEEPALIVE void AccountMirrorSetLocalEntity() {
+    AccountMirror::instance().setLocalEntity(staging.entity);
+}
+
+void AccountMirror::connectFeed() {
+    EM_ASM({
+        if (!window.SolanaGameBridge || !window.SolanaGameBridge.subscribeAccounts) {
+            console.warn('AccountMirror: SolanaGameBridge.subscribeAccounts not available');
+            return;
+        }
+        const addressAt = $0 + $1;
+        const entityAt = $0 + $2;
+        const dataAt = $0 + $3;
+        const ADDRESS_SIZE = $4;
+        const MAX_DATA_SIZE = $5;
+
+        // update: { address, entity, slot, data: Uint8Array } (already base64-decoded)
+        window.SolanaGameBridge.subscribeAccounts({
+            onAccount: (update) => {
+                stringToUTF8(update.address, addressAt, ADDRESS_SIZE);
+                stringToUTF8(update.entity || "", entityAt, ADDRESS_SIZE);
+                if (update.data.length <= MAX_DATA_SIZE) HEAPU8.set(update.data, dataAt);
+                _AccountMirrorPush(update.slot, update.data.length);
+            },
+            onLocalEntity: (entity) => {
+                stringToUTF8(entity, entityAt, ADDRESS_SIZE);
+                _AccountMirrorSetLocalEntity();
+            }
+        });
+    }, &staging, offsetof(FeedStaging, address), offsetof(FeedStaging, entity), offsetof(FeedStaging, data),
+       AccountRecord::ADDRESS_SIZE, AccountRecord::MAX_DATA_SIZE);
+}
+
+#else
+
+static void onMockAccount(const char* address, const char* entity, uint64_t slot, const uint8_t* data, size_t size) {
+    AccountMirror::instance().apply(address, entity, slot, data, size);
+}
+
+void AccountMirror::connectFeed() {
+    if (!NativeBridgeEnabled()) return;
+    MockChain& chain = MockChain::instance();
+    setLocalEntity(chain.entity(MockChain::LOCAL_PLAYER).address);
+    chain.setAccountListener(onMockAccount);
+}
+
+#endif
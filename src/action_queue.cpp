@@ -0,0 +1,330 @@
+#include "action_queue.h"
+#include <cstring>
+#include "bridge_latency.h"
+
+#include "shoot.h"
+#include "reload.h"
+#include "movement.h"
+#include "switch_weapon.h"
+#include "apply_damage.h"
+#include "send_transaction.h"
+#include "tx_templates.h"
+
+ActionQueue& ActionQueue::instance() {
+    static ActionQueue queue;
+    return queue;
+}
+
+ActionQueue::ActionQueue() {
+    head = 0;
+    count = 0;
+    inFlight = 0;
+    maxInFlight = DEFAULT_MAX_IN_FLIGHT;
+    enabled = false;
+    listenerCount = 0;
+    nextId = 1;
+    memset(transactions, 0, sizeof(transactions));
+    memset(&totals, 0, sizeof(totals));
+    lastErrorText[0] = '\0';
+}
+
+void ActionQueue::setEnabled(bool enabled) {
+    if (this->enabled && !enabled) clear();
+    this->enabled = enabled;
+}
+
+void ActionQueue::setMaxInFlight(int limit) {
+    if (limit < 1) limit = 1;
+    if (limit > MAX_IN_FLIGHT) limit = MAX_IN_FLIGHT;
+    maxInFlight = limit;
+}
+
+bool ActionQueue::addResultListener(ActionResultListener listener, void* user) {
+    if (listenerCount == MAX_LISTENERS) return false;
+    listeners[listenerCount++] = (Listener){ listener, user };
+    return true;
+}
+
+void ActionQueue::removeResultListener(ActionResultListener listener, void* user) {
+    for (int i = 0; i < listenerCount; i++) {
+        if (listeners[i].callback == listener && listeners[i].user == user) {
+            listeners[i] = listeners[--listenerCount];
+            i--;
+        }
+    }
+}
+
+void ActionQueue::notify(ActionId id, uint8_t type, bool success, const char* error) {
+    for (int i = 0; i < listenerCount; i++) {
+        listeners[i].callback(id, type, success, error, listeners[i].user);
+    }
+}
+
+ActionQueue::QueuedAction* ActionQueue::findWaiting(uint8_t type, uint8_t weaponSlot, bool matchSlot) {
+    for (int i = 0; i < count; i++) {
+        QueuedAction& queued = ring[(head + i) % CAPACITY];
+        if (queued.action.type != type) continue;
+        if (matchSlot && queued.action.weaponSlot != weaponSlot) continue;
+        return &queued;
+    }
+    return nullptr;
+}
+
+ActionId ActionQueue::push(const BatchAction& action, const char* victimAddress, bool isEvent) {
+    int limit = isEvent ? CAPACITY - STATE_RESERVE : CAPACITY;
+    if (count >= limit) {
+        totals.dropped++;
+        return 0;
+    }
+    QueuedAction& queued = ring[(head + count) % CAPACITY];
+    queued.action = action;
+    queued.id = nextId++;
+    if (nextId == 0) nextId = 1;
+    queued.action.victimAddress = nullptr;
+    queued.victimAddress[0] = '\0';
+    if (victimAddress) {
+        strncpy(queued.victimAddress, victimAddress, VICTIM_ADDRESS_SIZE - 1);
+        queued.victimAddress[VICTIM_ADDRESS_SIZE - 1] = '\0';
+    }
+    count++;
+    totals.enqueued++;
+    return queued.id;
+}
+
+ActionId ActionQueue::enqueueMovement(Vector3 position, float rotation, Vector3 velocity) {
+    if (!enabled) return 0;
+
+    BatchAction action = {};
+    action.type = BATCH_ACTION_MOVEMENT;
+    action.args[0] = position.x;
+    action.args[1] = position.y;
+    action.args[2] = position.z;
+    action.args[3] = rotation;
+    action.args[4] = velocity.x;
+    action.args[5] = velocity.y;
+    action.args[6] = velocity.z;
+
+    // Only the newest position matters
+    QueuedAction* waiting = findWaiting(BATCH_ACTION_MOVEMENT, 0, false);
+    if (waiting) {
+        waiting->action = action;
+        totals.coalesced++;
+        return waiting->id;
+    }
+    return push(action, nullptr, false);
+}
+
+ActionId ActionQueue::enqueueShoot(uint8_t weaponSlot) {
+    if (!enabled) return 0;
+
+    // Every shot spends ammo on-chain, so shots are never merged
+    BatchAction action = {};
+    action.type = BATCH_ACTION_SHOOT;
+    action.weaponSlot = weaponSlot;
+    return push(action, nullptr, true);
+}
+
+ActionId ActionQueue::enqueueReload(uint8_t weaponSlot) {
+    if (!enabled) return 0;
+
+    // A second reload before the first is sent does nothing extra, unless
+    // shots from that magazine are queued between them
+    QueuedAction* waiting = nullptr;
+    for (int i = 0; i < count; i++) {
+        QueuedAction& queued = ring[(head + i) % CAPACITY];
+        if (queued.action.weaponSlot != weaponSlot) continue;
+        if (queued.action.type == BATCH_ACTION_RELOAD) waiting = &queued;
+        else if (queued.action.type == BATCH_ACTION_SHOOT) waiting = nullptr;
+    }
+    if (waiting) {
+        totals.coalesced++;
+        return waiting->id;
+    }
+    BatchAction action = {};
+    action.type = BATCH_ACTION_RELOAD;
+    action.weaponSlot = weaponSlot;
+    return push(action, nullptr, false);
+}
+
+ActionId ActionQueue::enqueueSwitchWeapon(uint8_t weaponSlot) {
+    if (!enabled) return 0;
+
+    // Only the last selected slot matters
+    QueuedAction* waiting = findWaiting(BATCH_ACTION_SWITCH_WEAPON, 0, false);
+    if (waiting) {
+        waiting->action.weaponSlot = weaponSlot;
+        totals.coalesced++;
+        return waiting->id;
+    }
+    BatchAction action = {};
+    action.type = BATCH_ACTION_SWITCH_WEAPON;
+    action.weaponSlot = weaponSlot;
+    return push(action, nullptr, false);
+}
+
+ActionId ActionQueue::enqueueApplyDamage(const char* victimAddress, uint8_t weaponType, bool isHeadshot, float distance) {
+    if (!enabled) return 0;
+
+    BatchAction action = {};
+    action.type = BATCH_ACTION_APPLY_DAMAGE;
+    action.weaponSlot = weaponType;
+    action.isHeadshot = isHeadshot ? 1 : 0;
+    action.args[0] = distance;
+    return push(action, victimAddress, true);
+}
+
+void ActionQueue::expire(double now) {
+    for (int slot = 0; slot < SLOTS; slot++) {
+        if (!transactions[slot].active || now - transactions[slot].sentAt < TIMEOUT_MS) continue;
+        complete(slot, false, "Transaction timed out");
+        transactions[slot].expired = true;
+        totals.timedOut++;
+    }
+}
+
+// A slot with no answer outstanding, or -1. A timed-out slot stays taken
+// until its late answer arrives, so that answer can never complete a newer
+// transaction.
+int ActionQueue::freeSlot() const {
+    for (int slot = 0; slot < SLOTS; slot++) {
+        if (!transactions[slot].active && !transactions[slot].expired) return slot;
+    }
+    return -1;
+}
+
+void ActionQueue::pump() {
+    pump(BridgeLatency::now());
+}
+
+void ActionQueue::pump(double now) {
+    expire(now);
+
+    while (count > 0 && inFlight < maxInFlight) {
+        int batchSize = count < MAX_BATCH ? count : MAX_BATCH;
+
+        // One callback per transaction slot, see onSent
+        static const ExecuteBatchCallback SENT[SLOTS] = {
+            &onSent<0>, &onSent<1>, &onSent<2>, &onSent<3>, &onSent<4>, &onSent<5>, &onSent<6>, &onSent<7>,
+            &onSent<8>, &onSent<9>, &onSent<10>, &onSent<11>, &onSent<12>, &onSent<13>, &onSent<14>, &onSent<15>
+        };
+        static_assert(SLOTS == 16, "SENT needs one callback per slot");
+        // Every slot still owed an answer: the actions wait, as they do at the cap
+        int slot = freeSlot();
+        if (slot < 0) break;
+        Transaction& transaction = transactions[slot];
+        transaction.active = true;
+        transaction.expired = false;
+        transaction.sentAt = now;
+        transaction.count = batchSize;
+        ExecuteBatchCallback sent = SENT[slot];
+
+        // Copy out before sending: a helper can call back synchronously,
+        // and the slots are free for reuse as soon as they leave the ring
+        BatchAction batch[MAX_BATCH];
+        char victims[MAX_BATCH][VICTIM_ADDRESS_SIZE];
+        for (int i = 0; i < batchSize; i++) {
+            const QueuedAction& queued = ring[(head + i) % CAPACITY];
+            batch[i] = queued.action;
+            memcpy(victims[i], queued.victimAddress, VICTIM_ADDRESS_SIZE);
+            batch[i].victimAddress = victims[i][0] ? victims[i] : nullptr;
+            transaction.ids[i] = queued.id;
+            transaction.types[i] = queued.action.type;
+        }
+        head = (head + batchSize) % CAPACITY;
+        count -= batchSize;
+
+        inFlight++;
+        totals.sent++;
+
+        // Prepared message with the arguments patched in, when the session has one
+        uint32_t messageSize = 0;
+        const uint8_t* message = TxTemplates::instance().build(batch, batchSize, &messageSize);
+        if (message) {
+            SendPreparedTransaction(message, messageSize, sent);
+            continue;
+        }
+
+        if (batchSize > 1) {
+            ExecuteBatch(batch, batchSize, sent);
+            continue;
+        }
+
+        // Lone actions use the regular per-instruction bridge calls
+        const BatchAction& action = batch[0];
+        switch (action.type) {
+            case BATCH_ACTION_MOVEMENT:
+                UpdateMovement(action.args[0], action.args[1], action.args[2], action.args[3],
+                               action.args[4], action.args[5], action.args[6], sent);
+                break;
+            case BATCH_ACTION_SHOOT:
+                Shoot(action.weaponSlot, sent);
+                break;
+            case BATCH_ACTION_RELOAD:
+                Reload(action.weaponSlot, sent);
+                break;
+            case BATCH_ACTION_SWITCH_WEAPON:
+                SwitchWeapon(action.weaponSlot, sent);
+                break;
+            case BATCH_ACTION_APPLY_DAMAGE:
+                ApplyDamage(action.victimAddress ? action.victimAddress : "", action.weaponSlot,
+                            action.isHeadshot, action.args[0], sent);
+                break;
+            default:
+                complete(slot, false, "Unknown action");
+                break;
+        }
+    }
+}
+
+void ActionQueue::clear() {
+    // Nothing waiting will be sent; tell whoever predicted it
+    while (count > 0) {
+        QueuedAction queued = ring[head];
+        head = (head + 1) % CAPACITY;
+        count--;
+        notify(queued.id, queued.action.type, false, "Cancelled");
+    }
+    head = 0;
+}
+
+ActionQueueStats ActionQueue::stats() const {
+    ActionQueueStats current = totals;
+    current.depth = count;
+    current.inFlight = inFlight;
+    return current;
+}
+
+void ActionQueue::complete(int slot, bool success, const char* error) {
+    // Too late: its actions already failed
+    if (transactions[slot].expired) {
+        transactions[slot].expired = false;
+        return;
+    }
+    Transaction transaction = transactions[slot];
+    if (!transaction.active) return;
+    transactions[slot].active = false;
+    if (inFlight > 0) inFlight--;
+
+    if (!success && !error) error = "Unknown error";
+    for (int i = 0; i < transaction.count; i++) {
+        notify(transaction.ids[i], transaction.types[i], success, error);
+    }
+
+    if (success) {
+        totals.succeeded++;
+        return;
+    }
+    totals.failed++;
+
+    // Log each distinct failure once instead of once per transaction
+    if (strncmp(lastErrorText, error, ERROR_SIZE - 1) != 0) {
+        strncpy(lastErrorText, error, ERROR_SIZE - 1);
+        lastErrorText[ERROR_SIZE - 1] = '\0';
+        TraceLog(LOG_WARNING, "ACTION QUEUE: Transaction failed: %s", lastErrorText);
+    }
+}
+
+template <int Slot>
+void ActionQueue::onSent(bool success, const char* error) {
+    instance().complete(Slot, success, error);
+}
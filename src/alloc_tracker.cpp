@@ -0,0 +1,85 @@
+#include "alloc_tracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> frameCounts[ALLOC_SUBSYSTEM_COUNT];
+static std::atomic<size_t> totalCount{ 0 };
+static thread_local AllocSubsystem activeSubsystem = ALLOC_OTHER;
+
+static const char* subsystemNames[ALLOC_SUBSYSTEM_COUNT] = {
+    "other", "player", "map", "effects", "ui", "bridge", "render"
+};
+
+#if defined(SOLFPS_ALLOC_TRACKING)
+// Global allocation hook: every operator new in the process lands here
+void* operator new(size_t size) {
+    frameCounts[activeSubsystem].fetch_add(1, std::memory_order_relaxed);
+    totalCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+#endif
+
+bool AllocTracker::enabled() {
+#if defined(SOLFPS_ALLOC_TRACKING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocTracker::beginFrame() {
+    for (int i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++) {
+        frameCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t AllocTracker::frameAllocations() {
+    size_t total = 0;
+    for (int i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++) {
+        total += frameCounts[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t AllocTracker::frameAllocations(AllocSubsystem subsystem) {
+    return frameCounts[subsystem].load(std::memory_order_relaxed);
+}
+
+size_t AllocTracker::totalAllocations() {
+    return totalCount.load(std::memory_order_relaxed);
+}
+
+AllocSubsystem AllocTracker::currentSubsystem() {
+    return activeSubsystem;
+}
+
+void AllocTracker::setSubsystem(AllocSubsystem subsystem) {
+    activeSubsystem = subsystem;
+}
+
+const char* AllocTracker::subsystemName(AllocSubsystem subsystem) {
+    return subsystemNames[subsystem];
+}
+
+void AllocTracker::printFrameReport(const char* label) {
+    for (int i = 0; i < ALLOC_SUBSYSTEM_COUNT; i++) {
+        size_t count = frameCounts[i].load(std::memory_order_relaxed);
+        if (count > 0) {
+            printf("%s: %zu allocation(s) in %s\n", label, count, subsystemNames[i]);
+        }
+    }
+}
+
+AllocScope::AllocScope(AllocSubsystem subsystem) : previous(activeSubsystem) {
+    activeSubsystem = subsystem;
+}
+
+AllocScope::~AllocScope() {
+    activeSubsystem = previous;
+}
@@ -0,0 +1,217 @@
+#include "asset_loader.h"
+#include <raylib.h>
+#include <chrono>
+#include <cstring>
+
+// Web builds only get workers when compiled with pthreads
+#if !defined(PLATFORM_WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+#define ASSET_LOADER_THREADS 1
+#else
+#define ASSET_LOADER_THREADS 0
+#endif
+
+AssetLoader& AssetLoader::instance() {
+    static AssetLoader loader;
+    return loader;
+}
+
+AssetLoader::AssetLoader() {
+    memset(jobs, 0, sizeof(jobs));
+    submitted = 0;
+    outstanding = 0;
+    criticalTotal = 0;
+    criticalDone = 0;
+    workerCount = 0;
+    stopping = false;
+}
+
+// Workers drain the queue before leaving; nothing completes from here
+AssetLoader::~AssetLoader() {
+    if (workerCount == 0) return;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].join();
+    }
+}
+
+void AssetLoader::start() {
+#if ASSET_LOADER_THREADS
+    if (workerCount > 0) return;
+    unsigned int cores = std::thread::hardware_concurrency();
+    int count = cores > 1 ? (int)cores - 1 : 1;   // Leave the main thread its core
+    if (count > MAX_WORKERS) count = MAX_WORKERS;
+    stopping = false;
+    for (int i = 0; i < count; i++) {
+        workers[i] = std::thread(&AssetLoader::workerLoop, this);
+    }
+    workerCount = count;
+    TraceLog(LOG_INFO, "ASSET LOADER: %d worker threads", count);
+#endif
+}
+
+void AssetLoader::stop() {
+    finish();
+    if (workerCount == 0) return;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].join();
+    }
+    workerCount = 0;
+}
+
+bool AssetLoader::submit(const char* name, bool critical, AssetWork work, AssetDone done, void* user) {
+    return queue(name, critical, false, work, done, user);
+}
+
+bool AssetLoader::submitMainThread(const char* name, bool critical, AssetWork work, AssetDone done, void* user) {
+    return queue(name, critical, true, work, done, user);
+}
+
+bool AssetLoader::queue(const char* name, bool critical, bool mainThread, AssetWork work, AssetDone done, void* user) {
+    std::unique_lock<std::mutex> guard(lock);
+    Job* job = nullptr;
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (jobs[i].state == JOB_FREE) {
+            job = &jobs[i];
+            break;
+        }
+    }
+    if (!job) {
+        guard.unlock();
+        TraceLog(LOG_WARNING, "ASSET LOADER: Queue full, loading %s inline", name);
+        if (work) work(user);
+        if (done) done(user);
+        return false;
+    }
+
+    job->state = JOB_QUEUED;
+    job->critical = critical;
+    job->mainThread = mainThread;
+    job->order = submitted++;
+    strncpy(job->name, name, NAME_SIZE - 1);
+    job->name[NAME_SIZE - 1] = '\0';
+    job->work = work;
+    job->done = done;
+    job->user = user;
+    outstanding++;
+    if (critical) criticalTotal++;
+    guard.unlock();
+    if (!mainThread) wake.notify_one();
+    return true;
+}
+
+int AssetLoader::takeOldest(bool mainThread) {
+    int oldest = -1;
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (jobs[i].state != JOB_QUEUED || jobs[i].mainThread != mainThread) continue;
+        if (oldest < 0 || (int32_t)(jobs[i].order - jobs[oldest].order) < 0) oldest = i;
+    }
+    if (oldest >= 0) jobs[oldest].state = JOB_RUNNING;
+    return oldest;
+}
+
+void AssetLoader::workerLoop() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        int index = takeOldest(false);
+        if (index < 0) {
+            if (stopping) return;
+            wake.wait(guard);
+            continue;
+        }
+        Job& job = jobs[index];
+        guard.unlock();
+        if (job.work) job.work(job.user);
+        guard.lock();
+        job.state = JOB_FINISHED;
+    }
+}
+
+void AssetLoader::complete(Job& job) {
+    AssetDone done = job.done;
+    void* user = job.user;
+    bool critical = job.critical;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        job.state = JOB_FREE;
+    }
+    outstanding--;
+    if (critical) criticalDone++;
+    if (done) done(user);
+}
+
+bool AssetLoader::runOldest(bool mainThread) {
+    int index;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        index = takeOldest(mainThread);
+    }
+    if (index < 0) return false;
+    if (jobs[index].work) jobs[index].work(jobs[index].user);
+    std::lock_guard<std::mutex> guard(lock);
+    jobs[index].state = JOB_FINISHED;
+    return true;
+}
+
+int AssetLoader::update() {
+    // Work that can only run here, whatever the workers are doing
+    while (runOldest(true)) {}
+
+    if (workerCount == 0) {
+        // No threads: do queued work here until the slice is used up
+        double sliceEnd = GetTime() + SLICE_SECONDS;
+        while (GetTime() < sliceEnd && runOldest(false)) {}
+    }
+
+    // Hand finished results over, oldest first
+    int completed = 0;
+    while (true) {
+        int next = -1;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (int i = 0; i < MAX_JOBS; i++) {
+                if (jobs[i].state != JOB_FINISHED) continue;
+                if (next < 0 || (int32_t)(jobs[i].order - jobs[next].order) < 0) next = i;
+            }
+        }
+        if (next < 0) break;
+        complete(jobs[next]);
+        completed++;
+    }
+    return completed;
+}
+
+void AssetLoader::finish() {
+    while (outstanding > 0) {
+        if (update() == 0 && workerCount > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+float AssetLoader::progress() const {
+    return criticalTotal > 0 ? (float)criticalDone / (float)criticalTotal : 1.0f;
+}
+
+const char* AssetLoader::pending() const {
+    std::lock_guard<std::mutex> guard(lock);
+    const char* name = "";
+    uint32_t oldest = 0;
+    for (int i = 0; i < MAX_JOBS; i++) {
+        const Job& job = jobs[i];
+        if (job.state == JOB_FREE || !job.critical) continue;
+        if (!*name || (int32_t)(job.order - oldest) < 0) {
+            name = job.name;
+            oldest = job.order;
+        }
+    }
+    return name;
+}
@@ -0,0 +1,243 @@
+#include "asset_pack.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+#elif !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define ASSET_PACK_MMAP 1
+#endif
+
+// raylib's inflate (external/sinfl.h, built into rcore with the compression
+// API). DecompressData would reserve 64 MB per call; the index already
+// knows each payload's size.
+extern "C" int sinflate(void* out, int cap, const void* in, int size);
+
+static const char PACK_MAGIC[4] = { 'S', 'P', 'A', 'K' };
+static const uint32_t PACK_VERSION = 1;
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t packCount;
+};
+
+static_assert(sizeof(AssetPackEntry) == 128, "AssetPackEntry must match tools/pack_assets.py");
+static_assert(sizeof(PackHeader) == 16, "PackHeader must match tools/pack_assets.py");
+
+AssetPack& AssetPack::instance() {
+    static AssetPack pack;
+    return pack;
+}
+
+AssetPack::AssetPack() {
+    memset(packs, 0, sizeof(packs));
+    packCount = 0;
+    entries = nullptr;
+    entryCount = 0;
+    memset(&totals, 0, sizeof(totals));
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::load(Pack& pack, const char* path) {
+#if ASSET_PACK_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);    // The mapping outlives the descriptor
+    if (data == MAP_FAILED) return false;
+    pack.data = (const unsigned char*)data;
+    pack.size = (size_t)info.st_size;
+    pack.mapped = true;
+#else
+    int size = 0;
+    unsigned char* data = LoadFileData(path, &size);
+    if (!data) return false;
+    pack.data = data;
+    pack.size = (size_t)size;
+    pack.mapped = false;
+    #if defined(PLATFORM_WEB)
+        remove(path);   // MEMFS holds its own copy of the preloaded file
+    #endif
+#endif
+    pack.state = PACK_RESIDENT;
+    totals.resident++;
+    totals.bytes += pack.size;
+    return true;
+}
+
+bool AssetPack::open(const char* path) {
+    close();
+    Pack& main = packs[0];
+    if (!load(main, path)) {
+        TraceLog(LOG_INFO, "ASSET PACK: No %s, loading loose files", path);
+        return false;
+    }
+
+    PackHeader header;
+    bool valid = main.size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, main.data, sizeof(header));
+        size_t indexSize = sizeof(header) + (size_t)header.packCount * PACK_NAME_SIZE +
+                           (size_t)header.entryCount * sizeof(AssetPackEntry);
+        valid = memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) == 0 && header.version == PACK_VERSION &&
+                header.packCount >= 1 && header.packCount <= (uint32_t)MAX_PACKS && indexSize <= main.size;
+    }
+    if (!valid) {
+        TraceLog(LOG_WARNING, "ASSET PACK: %s is not a version %u pack", path, PACK_VERSION);
+        close();
+        return false;
+    }
+
+    packCount = (int)header.packCount;
+    const unsigned char* names = main.data + sizeof(header);
+    for (int i = 0; i < packCount; i++) {
+        memcpy(packs[i].name, names + i * PACK_NAME_SIZE, PACK_NAME_SIZE);
+        packs[i].name[PACK_NAME_SIZE - 1] = '\0';
+    }
+    entries = (const AssetPackEntry*)(names + packCount * PACK_NAME_SIZE);
+    entryCount = (int)header.entryCount;
+    totals.entries = entryCount;
+    totals.packs = packCount;
+
+    // The rest sit next to the main pack (next to the page, on the web)
+    const char* slash = strrchr(path, '/');
+    int dirLength = slash ? (int)(slash - path) + 1 : 0;
+    for (int i = 1; i < packCount; i++) {
+        char other[256];
+        snprintf(other, sizeof(other), "%.*s%s", dirLength, path, packs[i].name);
+        fetch(i, other);
+    }
+
+    TraceLog(LOG_INFO, "ASSET PACK: %d entries in %d packs", entryCount, packCount);
+    return true;
+}
+
+void AssetPack::fetch(int index, const char* url) {
+    Pack& pack = packs[index];
+#if defined(PLATFORM_WEB)
+    pack.state = PACK_FETCHING;
+    emscripten_async_wget_data(url, (void*)(intptr_t)index, fetched, fetchFailed);
+#else
+    if (!load(pack, url)) {
+        TraceLog(LOG_WARNING, "ASSET PACK: Could not open %s", url);
+        pack.state = PACK_FAILED;
+    }
+#endif
+}
+
+// Main thread, from the browser's event loop. `data` is freed after return.
+void AssetPack::fetched(void* user, void* data, int size) {
+    AssetPack& self = instance();
+    Pack& pack = self.packs[(intptr_t)user];
+    if (pack.state != PACK_FETCHING) return;    // Closed meanwhile
+    unsigned char* copy = (unsigned char*)MemAlloc((unsigned int)size);
+    memcpy(copy, data, (size_t)size);
+    pack.data = copy;
+    pack.size = (size_t)size;
+    pack.mapped = false;
+    pack.state = PACK_RESIDENT;
+    self.totals.resident++;
+    self.totals.bytes += pack.size;
+    TraceLog(LOG_INFO, "ASSET PACK: %s arrived, %d bytes", pack.name, size);
+}
+
+void AssetPack::fetchFailed(void* user) {
+    Pack& pack = instance().packs[(intptr_t)user];
+    if (pack.state != PACK_FETCHING) return;
+    pack.state = PACK_FAILED;
+    TraceLog(LOG_WARNING, "ASSET PACK: Could not fetch %s", pack.name);
+}
+
+void AssetPack::close() {
+    for (int i = 0; i < MAX_PACKS; i++) {
+        Pack& pack = packs[i];
+        if (pack.data) {
+#if ASSET_PACK_MMAP
+            if (pack.mapped) munmap((void*)pack.data, pack.size);
+#endif
+            if (!pack.mapped) MemFree((void*)pack.data);
+        }
+        // A fetch still in flight finds the slot no longer fetching and drops its data
+        memset(&pack, 0, sizeof(pack));
+    }
+    packCount = 0;
+    entries = nullptr;
+    entryCount = 0;
+    memset(&totals, 0, sizeof(totals));
+}
+
+const AssetPackEntry* AssetPack::find(const char* name) const {
+    int low = 0;
+    int high = entryCount - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        int order = strncmp(entries[middle].name, name, AssetPackEntry::NAME_SIZE);
+        if (order == 0) return &entries[middle];
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return nullptr;
+}
+
+AssetPack::PackState AssetPack::state(const AssetPackEntry* entry) const {
+    if (!entry || entry->pack >= packCount) return PACK_MISSING;
+    return packs[entry->pack].state;
+}
+
+Wave AssetPack::loadWave(const AssetPackEntry* entry) const {
+    Wave wave = { 0 };
+    if (!resident(entry)) return wave;
+    const Pack& pack = packs[entry->pack];
+    if ((size_t)entry->offset + entry->storedSize > pack.size) {
+        TraceLog(LOG_WARNING, "ASSET PACK: %s runs past the end of %s", entry->name, pack.name);
+        return wave;
+    }
+
+    const unsigned char* stored = pack.data + entry->offset;
+    const unsigned char* bytes = stored;
+    unsigned char* inflated = nullptr;
+    if (entry->compression == COMPRESSION_DEFLATE) {
+        inflated = (unsigned char*)MemAlloc(entry->size);
+        if (sinflate(inflated, (int)entry->size, stored, (int)entry->storedSize) != (int)entry->size) {
+            TraceLog(LOG_WARNING, "ASSET PACK: Could not inflate %s", entry->name);
+            MemFree(inflated);
+            return wave;
+        }
+        bytes = inflated;
+    }
+
+    if (entry->format == FORMAT_PCM) {
+        // Already samples: the Wave owns a buffer, so stored ones get copied
+        if (!inflated) {
+            inflated = (unsigned char*)MemAlloc(entry->size);
+            memcpy(inflated, stored, entry->size);
+        }
+        wave.frameCount = entry->frameCount;
+        wave.sampleRate = entry->sampleRate;
+        wave.sampleSize = entry->sampleSize;
+        wave.channels = entry->channels;
+        wave.data = inflated;
+        return wave;
+    }
+
+    wave = LoadWaveFromMemory(GetFileExtension(entry->name), bytes, (int)entry->size);
+    if (inflated) MemFree(inflated);
+    return wave;
+}
@@ -0,0 +1,102 @@
+#include "bridge_events.h"
+#include <raylib.h>
+#include <cstring>
+#include "bridge_latency.h"
+
+static_assert((BridgeEvents::CAPACITY & (BridgeEvents::CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+static_assert(BridgeEvents::CAPACITY >= 4 * BridgeEvents::MAX_SETTLING, "CAPACITY must leave room for rejections");
+
+BridgeEvents& BridgeEvents::instance() {
+    static BridgeEvents events;
+    return events;
+}
+
+BridgeEvents::BridgeEvents() : enqueueAt(0), dequeueAt(0), refused(0) {
+    for (uint32_t i = 0; i < (uint32_t)CAPACITY; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    memset(&totals, 0, sizeof(totals));
+}
+
+static void fill(BridgeEvent& event, uint32_t sequence, uint8_t instruction, NativeBridgeCallback callback,
+                 double submittedAt, double settledAt, const char* error) {
+    event.sequence = sequence;
+    event.instruction = instruction;
+    event.success = error == nullptr;
+    event.submittedAt = submittedAt;
+    event.settledAt = settledAt;
+    event.error[0] = '\0';
+    if (error) {
+        strncpy(event.error, error, BridgeEvent::ERROR_SIZE - 1);
+        event.error[BridgeEvent::ERROR_SIZE - 1] = '\0';
+    }
+    event.callback = callback;
+}
+
+void BridgeEvents::run(const BridgeEvent& event) {
+    BridgeLatency::instance().record(event.instruction, event.settledAt - event.submittedAt,
+                                     event.success ? nullptr : event.error);
+    event.callback(event.success, event.success ? nullptr : event.error);
+}
+
+bool BridgeEvents::post(uint8_t instruction, NativeBridgeCallback callback, double submittedAt, double settledAt,
+                        const char* error) {
+    uint32_t position = enqueueAt.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+        cell = &cells[position & (CAPACITY - 1)];
+        uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+        int32_t difference = (int32_t)(sequence - position);
+        if (difference == 0) {
+            if (enqueueAt.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            cell = nullptr;
+            break;
+        } else {
+            position = enqueueAt.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (!cell) {
+        refused.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    fill(cell->event, position, instruction, callback, submittedAt, settledAt, error);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+int BridgeEvents::dispatch() {
+    // Only what was posted before this point runs now
+    uint32_t end = enqueueAt.load(std::memory_order_acquire);
+    uint32_t queued = end - dequeueAt;
+    if (queued > totals.peakDepth) totals.peakDepth = queued;
+
+    int ran = 0;
+    while (dequeueAt != end) {
+        Cell& cell = cells[dequeueAt & (CAPACITY - 1)];
+        // A producer that claimed this cell may still be writing it
+        if (cell.sequence.load(std::memory_order_acquire) != dequeueAt + 1) break;
+
+        // Copy out and free the cell before calling, so callbacks can post
+        BridgeEvent event = cell.event;
+        cell.sequence.store(dequeueAt + CAPACITY, std::memory_order_release);
+        dequeueAt++;
+        run(event);
+        ran++;
+    }
+
+    totals.dispatched += ran;
+    totals.lastDispatch = ran;
+    uint32_t refusals = refused.load(std::memory_order_relaxed);
+    if (refusals != totals.refused) {
+        TraceLog(LOG_WARNING, "BRIDGE EVENTS: Queue full, %u posts refused", refusals - totals.refused);
+        totals.refused = refusals;
+    }
+    return ran;
+}
+
+int BridgeEvents::depth() const {
+    return (int)(enqueueAt.load(std::memory_order_relaxed) - dequeueAt);
+}
@@ -0,0 +1,224 @@
+#include "bridge_latency.h"
+#include <raylib.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#if defined(PLATFORM_WEB)
+#include <emscripten.h>
+#else
+#include <chrono>
+#endif
+
+void LatencyHistogram::reset() {
+    memset(counts, 0, sizeof(counts));
+    total = 0;
+    sum = 0;
+    minimum = 0;
+    maximum = 0;
+}
+
+// Bucket b holds values with b bits below the sub-bucket resolution; the
+// first bucket is linear over 0..SUB_BUCKET_COUNT-1, every later one covers
+// the upper half of its range
+int LatencyHistogram::indexFor(uint64_t value) {
+    int bucket = 0;
+    while ((value >> bucket) >= (uint64_t)SUB_BUCKET_COUNT) bucket++;
+    if (bucket >= BUCKET_COUNT) return COUNTS - 1;
+    return bucket * (SUB_BUCKET_COUNT / 2) + (int)(value >> bucket);
+}
+
+uint64_t LatencyHistogram::highestEquivalent(int index) {
+    int bucket = index / (SUB_BUCKET_COUNT / 2) - 1;
+    if (bucket < 0) bucket = 0;
+    uint64_t sub = (uint64_t)(index - bucket * (SUB_BUCKET_COUNT / 2));
+    return ((sub + 1) << bucket) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    counts[indexFor(micros)]++;
+    if (total == 0 || micros < minimum) minimum = micros;
+    if (micros > maximum) maximum = micros;
+    total++;
+    sum += micros;
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const {
+    if (total == 0) return 0;
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)total + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < COUNTS; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t value = highestEquivalent(i);
+            return value < maximum ? value : maximum;
+        }
+    }
+    return maximum;
+}
+
+BridgeLatency& BridgeLatency::instance() {
+    static BridgeLatency latency;
+    return latency;
+}
+
+BridgeLatency::BridgeLatency() {
+    reset();
+}
+
+const char* BridgeLatency::instructionName(int instruction) {
+    static const char* names[BRIDGE_INSTRUCTION_COUNT] = {
+        "InitPlayer", "InitGame", "JoinGame", "LeaveGame", "SetReady", "StartGame", "EndGame",
+        "UpdateMovement", "Shoot", "Reload", "SwitchWeapon", "ApplyDamage", "Respawn", "ExecuteBatch",
+        "SendPrepared"
+    };
+    if (instruction < 0 || instruction >= BRIDGE_INSTRUCTION_COUNT) return "Unknown";
+    return names[instruction];
+}
+
+double BridgeLatency::now() {
+#if defined(PLATFORM_WEB)
+    return emscripten_get_now();
+#else
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point start = Clock::now();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+#endif
+}
+
+void BridgeLatency::reset() {
+    for (int i = 0; i < BRIDGE_INSTRUCTION_COUNT; i++) {
+        instructions[i].histogram.reset();
+        instructions[i].failed = 0;
+        instructions[i].failureKinds = 0;
+        instructions[i].otherFailures = 0;
+    }
+}
+
+void BridgeLatency::record(int instruction, double milliseconds, const char* error) {
+    if (instruction < 0 || instruction >= BRIDGE_INSTRUCTION_COUNT) return;
+    BridgeInstructionLatency& entry = instructions[instruction];
+
+    if (!error) {
+        entry.histogram.record(milliseconds > 0.0 ? (uint64_t)(milliseconds * 1000.0) : 0);
+        return;
+    }
+
+    // Failures are usually fast rejections; keep them out of the percentiles
+    entry.failed++;
+    for (int i = 0; i < entry.failureKinds; i++) {
+        if (strncmp(entry.failures[i].error, error, BridgeFailure::ERROR_SIZE - 1) == 0) {
+            entry.failures[i].count++;
+            return;
+        }
+    }
+    if (entry.failureKinds == BridgeInstructionLatency::MAX_FAILURE_KINDS) {
+        entry.otherFailures++;
+        return;
+    }
+    BridgeFailure& failure = entry.failures[entry.failureKinds++];
+    strncpy(failure.error, error, BridgeFailure::ERROR_SIZE - 1);
+    failure.error[BridgeFailure::ERROR_SIZE - 1] = '\0';
+    failure.count = 1;
+}
+
+uint64_t BridgeLatency::calls() const {
+    uint64_t calls = 0;
+    for (int i = 0; i < BRIDGE_INSTRUCTION_COUNT; i++) {
+        calls += instructions[i].histogram.count() + instructions[i].failed;
+    }
+    return calls;
+}
+
+// Appends to out[length..size), keeping it terminated; the length stops
+// growing once the buffer is full
+static int append(char* out, int size, int length, const char* format, ...) {
+    if (length >= size - 1) return length;
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(out + length, size - length, format, args);
+    va_end(args);
+    if (written < 0) return length;
+    return length + written < size - 1 ? length + written : size - 1;
+}
+
+static int appendQuoted(char* out, int size, int length, const char* text) {
+    length = append(out, size, length, "\"");
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') length = append(out, size, length, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20) length = append(out, size, length, "\\u%04x", (unsigned char)*c);
+        else length = append(out, size, length, "%c", *c);
+    }
+    return append(out, size, length, "\"");
+}
+
+int BridgeLatency::report(char* out, int size) const {
+    if (size <= 0) return 0;
+    out[0] = '\0';
+    int length = append(out, size, 0, "{\"instructions\":[");
+    bool first = true;
+    for (int i = 0; i < BRIDGE_INSTRUCTION_COUNT; i++) {
+        const BridgeInstructionLatency& entry = instructions[i];
+        const LatencyHistogram& histogram = entry.histogram;
+        if (histogram.count() == 0 && entry.failed == 0) continue;
+
+        length = append(out, size, length,
+                        "%s{\"name\":\"%s\",\"samples\":%llu,\"failed\":%u,"
+                        "\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"mean\":%.3f,\"errors\":{",
+                        first ? "" : ",", instructionName(i), (unsigned long long)histogram.count(), entry.failed,
+                        histogram.percentile(50.0) / 1000.0, histogram.percentile(95.0) / 1000.0,
+                        histogram.percentile(99.0) / 1000.0, histogram.max() / 1000.0, histogram.mean() / 1000.0);
+        for (int j = 0; j < entry.failureKinds; j++) {
+            if (j > 0) length = append(out, size, length, ",");
+            length = appendQuoted(out, size, length, entry.failures[j].error);
+            length = append(out, size, length, ":%u", entry.failures[j].count);
+        }
+        if (entry.otherFailures > 0) {
+            length = append(out, size, length, "%s\"other\":%u", entry.failureKinds > 0 ? "," : "", entry.otherFailures);
+        }
+        length = append(out, size, length, "}}");
+        first = false;
+    }
+    return append(out, size, length, "]}");
+}
+
+#if defined(PLATFORM_WEB)
+
+// For page scripts: UTF8ToString(_BridgeLatencyReport())
+extern "C" EMSCRIPTEN_KEEPALIVE const char* BridgeLatencyReport() {
+    static char json[BridgeLatency::REPORT_SIZE];
+    BridgeLatency::instance().report(json, sizeof(json));
+    return json;
+}
+
+void BridgeLatency::exportReport() const {
+    const char* json = BridgeLatencyReport();
+    EM_ASM({
+        const json = UTF8ToString($0);
+        console.log('Bridge latency:', json);
+        if (window.SolanaGameBridge && window.SolanaGameBridge.onLatencyReport) {
+            window.SolanaGameBridge.onLatencyReport(json);
+        }
+    }, json);
+}
+
+#else
+
+void BridgeLatency::exportReport() const {
+    static char json[REPORT_SIZE];
+    int length = report(json, sizeof(json));
+    FILE* file = fopen("bridge_latency.json", "w");
+    if (!file) {
+        TraceLog(LOG_WARNING, "BRIDGE LATENCY: Could not write bridge_latency.json");
+        return;
+    }
+    fwrite(json, 1, length, file);
+    fputc('\n', file);
+    fclose(file);
+    TraceLog(LOG_INFO, "BRIDGE LATENCY: Wrote bridge_latency.json (%llu calls)", (unsigned long long)calls());
+}
+
+#endif
@@ -0,0 +1,323 @@
+#include "bridge_mailbox.h"
+#include <cstddef>
+#include <cstring>
+#include "bridge_events.h"
+#include "bridge_latency.h"
+#include "execute_batch.h"
+
+#if defined(PLATFORM_WEB)
+#include <emscripten.h>
+#endif
+
+static_assert(sizeof(BridgeCommand) == 88, "BridgeCommand layout is shared with JS");
+static_assert(sizeof(BridgeResult) == 80, "BridgeResult layout is shared with JS");
+static_assert(BRIDGE_INSTRUCTION_COUNT == 15, "Update the JS call table in installMailbox");
+
+static const int COMMAND_CAPACITY = 64;
+static const int RESULT_CAPACITY = 64;
+static const int PAYLOAD_SIZE = 16384;     // Prepared messages since the last flush
+static const int MAX_PENDING = 256;        // Submitted and not yet polled
+
+// Everything JS touches. The counters run freely; index = counter % capacity.
+struct MailboxShared {
+    uint32_t commandHead;       // Written by C++
+    uint32_t commandTail;       // Written by JS
+    uint32_t resultHead;        // Written by JS
+    uint32_t resultTail;        // Written by C++
+    uint32_t payloadUsed;       // Reset by each flush
+    uint32_t resultBacklog;     // Results JS is holding because the ring was full
+    uint32_t reserved[2];
+    BridgeCommand commands[COMMAND_CAPACITY];
+    BridgeResult results[RESULT_CAPACITY];
+    uint8_t payload[PAYLOAD_SIZE];
+};
+
+struct MailboxPending {
+    uint32_t ticket;
+    uint8_t instruction;
+    double submittedAt;
+    BridgeMailboxCallback callback;
+};
+
+static MailboxShared shared;
+static MailboxPending pending[MAX_PENDING];
+static_assert(MAX_PENDING <= BridgeEvents::MAX_SETTLING, "BridgeEvents is sized for at most MAX_SETTLING pending");
+static uint32_t nextTicket = 1;
+
+static void fail(uint8_t instruction, BridgeMailboxCallback callback, const char* error) {
+    double now = BridgeLatency::now();
+    BridgeEvents::instance().post(instruction, callback, now, now, error);
+}
+
+static int freeCommands() {
+    return COMMAND_CAPACITY - (int)(shared.commandHead - shared.commandTail);
+}
+
+// Tickets index the pending table directly; a slot still waiting on an
+// older ticket means too much is outstanding
+static uint32_t reserveTicket(uint8_t instruction, BridgeMailboxCallback callback) {
+    uint32_t ticket = nextTicket;
+    MailboxPending& slot = pending[ticket % MAX_PENDING];
+    if (slot.callback) return 0;
+
+    nextTicket++;
+    if (nextTicket == 0) nextTicket = 1;
+    slot.ticket = ticket;
+    slot.instruction = instruction;
+    slot.submittedAt = BridgeLatency::now();
+    slot.callback = callback;
+    return ticket;
+}
+
+static BridgeCommand& pushCommand(uint32_t ticket, uint8_t instruction) {
+    BridgeCommand& command = shared.commands[shared.commandHead % COMMAND_CAPACITY];
+    memset(&command, 0, sizeof(command));
+    command.ticket = ticket;
+    command.instruction = instruction;
+    shared.commandHead++;
+    return command;
+}
+
+static void copyAddress(BridgeCommand& command, const char* address) {
+    if (!address) return;
+    strncpy(command.address, address, BRIDGE_MAILBOX_ADDRESS_SIZE - 1);
+}
+
+#if defined(PLATFORM_WEB)
+
+static bool installed = false;
+
+// Defines Module.bridgeMailbox: drain() starts the bridge call for every
+// command and JS writes each result into the ring when its promise settles
+static void installMailbox() {
+    EM_ASM({
+        const base = $0;
+        const commandsAt = base + $1;
+        const resultsAt = base + $2;
+        const payloadAt = base + $3;
+        const commandCapacity = $4;
+        const resultCapacity = $5;
+        const COMMAND_SIZE = 88;
+        const RESULT_SIZE = 80;
+        const ERROR_SIZE = 64;
+        const COMMAND_HEAD = base >> 2, COMMAND_TAIL = (base + 4) >> 2;
+        const RESULT_HEAD = (base + 8) >> 2, RESULT_TAIL = (base + 12) >> 2;
+        const PAYLOAD_USED = (base + 16) >> 2, RESULT_BACKLOG = (base + 20) >> 2;
+
+        // Same order as BridgeInstruction
+        const failures = [
+            "Init player failed", "Init game failed", "Join game failed", "Leave game failed",
+            "Set ready failed", "Start game failed", "End game failed", "Update movement failed",
+            "Shoot failed", "Reload failed", "Switch weapon failed", "Apply damage failed",
+            "Respawn failed", "Execute batch failed", "Send transaction failed"
+        ];
+
+        const backlog = [];
+
+        const store = (ticket, success, settledAt, error) => {
+            const head = HEAPU32[RESULT_HEAD];
+            if (((head - HEAPU32[RESULT_TAIL]) >>> 0) >= resultCapacity) return false;
+            const at = resultsAt + (head % resultCapacity) * RESULT_SIZE;
+            HEAPU32[at >> 2] = ticket;
+            HEAPU32[(at + 4) >> 2] = success ? 1 : 0;
+            HEAPF64[(at + 8) >> 3] = settledAt;
+            stringToUTF8(error, at + 16, ERROR_SIZE);
+            HEAPU32[RESULT_HEAD] = (head + 1) >>> 0;
+            return true;
+        };
+
+        const settle = (ticket, success, error) => {
+            const settledAt = performance.now();
+            if (backlog.length || !store(ticket, success, settledAt, error)) {
+                backlog.push([ticket, success, settledAt, error]);
+                HEAPU32[RESULT_BACKLOG] = backlog.length;
+            }
+        };
+
+        const args = (at) => Array.from(HEAPF32.subarray((at + 8) >> 2, (at + 36) >> 2));
+        const address = (at) => UTF8ToString(at + 40, 48);
+
+        const start = (bridge, at, actions) => {
+            const slot = HEAPU8[at + 5];
+            const a = args(at);
+            switch (HEAPU8[at + 4]) {
+                case 0: return bridge.initPlayer();
+                case 1: return bridge.initGame();
+                case 2: return bridge.joinGame(address(at));
+                case 3: return bridge.leaveGame();
+                case 4: return bridge.setReady(HEAPU8[at + 7]);
+                case 5: return bridge.startGame();
+                case 6: return bridge.endGame();
+                case 7: return bridge.updateMovement(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+                case 8: return bridge.shoot(slot);
+                case 9: return bridge.reload(slot);
+                case 10: return bridge.switchWeapon(slot);
+                case 11: return bridge.applyDamage(address(at), slot, HEAPU8[at + 6], a[0]);
+                case 12: return bridge.respawn();
+                case 13:
+                    if (bridge.executeBatch) return bridge.executeBatch(actions);
+                    // Older bridges get the individual calls, resolved together
+                    return Promise.all(actions.map(action => {
+                        const a = action.args;
+                        switch (action.type) {
+                            case 0: return bridge.updateMovement(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+                            case 1: return bridge.shoot(action.weaponSlot);
+                            case 2: return bridge.reload(action.weaponSlot);
+                            case 3: return bridge.switchWeapon(action.weaponSlot);
+                            case 4: return bridge.applyDamage(action.victimAddress, action.weaponSlot, action.isHeadshot, a[0]);
+                            default: return Promise.reject(new Error("Unknown batch action " + action.type));
+                        }
+                    }));
+                case 14: {
+                    const offset = payloadAt + HEAPU16[(at + 36) >> 1];
+                    const message = HEAPU8.slice(offset, offset + HEAPU16[(at + 38) >> 1]);
+                    return bridge.sendPreparedTransaction(message);
+                }
+                default: return Promise.reject(new Error("Unknown instruction"));
+            }
+        };
+
+        Module.bridgeMailbox = {
+            drain: () => {
+                while (backlog.length && store(...backlog[0])) backlog.shift();
+                HEAPU32[RESULT_BACKLOG] = backlog.length;
+
+                const bridge = window.SolanaGameBridge;
+                const head = HEAPU32[COMMAND_HEAD];
+                let tail = HEAPU32[COMMAND_TAIL];
+                while (tail !== head) {
+                    const at = commandsAt + (tail % commandCapacity) * COMMAND_SIZE;
+                    tail = (tail + 1) >>> 0;
+                    const ticket = HEAPU32[at >> 2];
+                    const instruction = HEAPU8[at + 4];
+
+                    // Decode a batch's actions now; the entries are reused after this returns
+                    let actions = null;
+                    if (instruction === 13) {
+                        actions = [];
+                        for (let i = HEAPU8[at + 7]; i > 0; i--) {
+                            const action = commandsAt + (tail % commandCapacity) * COMMAND_SIZE;
+                            tail = (tail + 1) >>> 0;
+                            const victim = address(action);
+                            actions.push({
+                                type: HEAPU8[action + 4],
+                                weaponSlot: HEAPU8[action + 5],
+                                isHeadshot: HEAPU8[action + 6],
+                                args: args(action),
+                                victimAddress: victim.length ? victim : null
+                            });
+                        }
+                    }
+
+                    if (!bridge || (instruction === 14 && !bridge.sendPreparedTransaction)) {
+                        settle(ticket, false, "SolanaGameBridge not initialized");
+                        continue;
+                    }
+                    let call;
+                    try {
+                        call = start(bridge, at, actions);
+                    } catch (err) {
+                        call = Promise.reject(err);
+                    }
+                    Promise.resolve(call)
+                        .then(() => settle(ticket, true, ""))
+                        .catch(err => settle(ticket, false, (err && err.message) || failures[instruction] || "Bridge call failed"));
+                }
+                HEAPU32[COMMAND_TAIL] = tail;
+                HEAPU32[PAYLOAD_USED] = 0;
+            }
+        };
+    }, &shared, offsetof(MailboxShared, commands), offsetof(MailboxShared, results),
+       offsetof(MailboxShared, payload), COMMAND_CAPACITY, RESULT_CAPACITY);
+    installed = true;
+}
+
+void BridgeMailboxFlush(void) {
+    if (shared.commandHead == shared.commandTail && shared.resultBacklog == 0) return;
+    if (!installed) installMailbox();
+    EM_ASM({ Module.bridgeMailbox.drain(); });
+}
+
+#endif
+
+void BridgeMailboxSubmit(const BridgeRequest* request, BridgeMailboxCallback callback) {
+    if (freeCommands() < 1) {
+        fail(request->instruction, callback, "Bridge mailbox full");
+        return;
+    }
+    uint32_t ticket = reserveTicket(request->instruction, callback);
+    if (!ticket) {
+        fail(request->instruction, callback, "Bridge mailbox full");
+        return;
+    }
+
+    BridgeCommand& command = pushCommand(ticket, request->instruction);
+    command.weaponSlot = request->weaponSlot;
+    command.isHeadshot = request->isHeadshot;
+    command.flag = request->flag;
+    memcpy(command.args, request->args, sizeof(command.args));
+    copyAddress(command, request->address);
+}
+
+void BridgeMailboxSubmitBatch(const struct BatchAction* actions, int count, BridgeMailboxCallback callback) {
+    if (count < 1 || count > 255) {
+        fail(BRIDGE_EXECUTE_BATCH, callback, "Invalid arguments");
+        return;
+    }
+    if (freeCommands() < count + 1) {
+        fail(BRIDGE_EXECUTE_BATCH, callback, "Bridge mailbox full");
+        return;
+    }
+    uint32_t ticket = reserveTicket(BRIDGE_EXECUTE_BATCH, callback);
+    if (!ticket) {
+        fail(BRIDGE_EXECUTE_BATCH, callback, "Bridge mailbox full");
+        return;
+    }
+
+    BridgeCommand& header = pushCommand(ticket, BRIDGE_EXECUTE_BATCH);
+    header.flag = (uint8_t)count;
+    for (int i = 0; i < count; i++) {
+        BridgeCommand& command = pushCommand(ticket, actions[i].type);
+        command.weaponSlot = actions[i].weaponSlot;
+        command.isHeadshot = actions[i].isHeadshot;
+        memcpy(command.args, actions[i].args, sizeof(command.args));
+        copyAddress(command, actions[i].victimAddress);
+    }
+}
+
+void BridgeMailboxSubmitMessage(const uint8_t* message, uint32_t size, BridgeMailboxCallback callback) {
+    if (freeCommands() < 1 || size > (uint32_t)(PAYLOAD_SIZE - shared.payloadUsed)) {
+        fail(BRIDGE_SEND_PREPARED, callback, "Bridge mailbox full");
+        return;
+    }
+    uint32_t ticket = reserveTicket(BRIDGE_SEND_PREPARED, callback);
+    if (!ticket) {
+        fail(BRIDGE_SEND_PREPARED, callback, "Bridge mailbox full");
+        return;
+    }
+
+    BridgeCommand& command = pushCommand(ticket, BRIDGE_SEND_PREPARED);
+    command.payloadOffset = (uint16_t)shared.payloadUsed;
+    command.payloadSize = (uint16_t)size;
+    memcpy(shared.payload + shared.payloadUsed, message, size);
+    shared.payloadUsed += size;
+}
+
+void BridgeMailboxPoll(void) {
+    while (shared.resultTail != shared.resultHead) {
+        BridgeResult& result = shared.results[shared.resultTail % RESULT_CAPACITY];
+        result.error[BRIDGE_MAILBOX_ERROR_SIZE - 1] = '\0';
+
+        // The event queue copies the error, so the result slot is free after this.
+        // While the queue is full the result stays in the ring for the next poll.
+        MailboxPending& slot = pending[result.ticket % MAX_PENDING];
+        if (slot.callback && slot.ticket == result.ticket) {
+            if (!BridgeEvents::instance().post(slot.instruction, slot.callback, slot.submittedAt, result.settledAt,
+                                               result.success ? nullptr : result.error)) {
+                break;
+            }
+            slot.callback = nullptr;
+        }
+        shared.resultTail++;
+    }
+}
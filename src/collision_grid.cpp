@@ -0,0 +1,163 @@
+#include "collision_grid.h"
+#include <raymath.h>
+#include <cfloat>
+#include <cmath>
+
+// Narrows [enter, exit] to where start + t * delta lies within [lo, hi] on
+// one axis; false once nothing is left
+static bool clipAxis(float start, float delta, float lo, float hi, float& enter, float& exit) {
+    if (fabsf(delta) < 1.0e-8f) return start >= lo && start <= hi;
+    float t0 = (lo - start) / delta;
+    float t1 = (hi - start) / delta;
+    if (t0 > t1) {
+        float swap = t0;
+        t0 = t1;
+        t1 = swap;
+    }
+    if (t0 > enter) enter = t0;
+    if (t1 < exit) exit = t1;
+    return enter <= exit;
+}
+
+CollisionGrid::CollisionGrid() {
+    originX = 0.0f;
+    originZ = 0.0f;
+    cellSize = CELL_SIZE;
+    columns = 0;
+    rows = 0;
+    groundHeight = 0.0f;
+}
+
+void CollisionGrid::build(const Map& map) {
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+    auto addBox = [this](Vector3 position, Vector3 size) {
+        minX.push_back(position.x - size.x / 2);
+        minY.push_back(position.y - size.y / 2);
+        minZ.push_back(position.z - size.z / 2);
+        maxX.push_back(position.x + size.x / 2);
+        maxY.push_back(position.y + size.y / 2);
+        maxZ.push_back(position.z + size.z / 2);
+    };
+    for (const auto& wall : map.walls) addBox(wall.position, wall.size);
+    for (const auto& platform : map.platforms) addBox(platform.position, platform.size);
+
+    // The grid covers the ground plane
+    originX = map.groundPosition.x - map.groundSize.x / 2;
+    originZ = map.groundPosition.z - map.groundSize.y / 2;
+    groundHeight = map.groundPosition.y;
+    cellSize = CELL_SIZE;
+    float largest = fmaxf(map.groundSize.x, map.groundSize.y);
+    if (largest / cellSize > MAX_CELLS_PER_SIDE) cellSize = largest / MAX_CELLS_PER_SIDE;
+    columns = (int)ceilf(map.groundSize.x / cellSize);
+    rows = (int)ceilf(map.groundSize.y / cellSize);
+    if (columns < 1) columns = 1;
+    if (rows < 1) rows = 1;
+
+    // Cells each box overlaps; boxes past the edge go in the border cells
+    auto cellRange = [this](int box, int& x0, int& z0, int& x1, int& z1) {
+        x0 = (int)Clamp(floorf((minX[box] - originX) / cellSize), 0.0f, (float)(columns - 1));
+        x1 = (int)Clamp(floorf((maxX[box] - originX) / cellSize), 0.0f, (float)(columns - 1));
+        z0 = (int)Clamp(floorf((minZ[box] - originZ) / cellSize), 0.0f, (float)(rows - 1));
+        z1 = (int)Clamp(floorf((maxZ[box] - originZ) / cellSize), 0.0f, (float)(rows - 1));
+    };
+
+    // Count, then fill each cell's run of refs
+    cellStart.assign(columns * rows + 1, 0);
+    int x0, z0, x1, z1;
+    for (int box = 0; box < boxCount(); box++) {
+        cellRange(box, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; z++) {
+            for (int x = x0; x <= x1; x++) cellStart[z * columns + x + 1]++;
+        }
+    }
+    for (int cell = 0; cell < columns * rows; cell++) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+    refs.assign(cellStart[columns * rows], 0);
+    std::vector<int> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (int box = 0; box < boxCount(); box++) {
+        cellRange(box, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; z++) {
+            for (int x = x0; x <= x1; x++) refs[cursor[z * columns + x]++] = box;
+        }
+    }
+}
+
+float CollisionGrid::segmentBox(int box, Vector3 from, Vector3 delta, float maxFraction) const {
+    float enter = 0.0f;
+    float exit = maxFraction;
+    if (!clipAxis(from.x, delta.x, minX[box], maxX[box], enter, exit)) return -1.0f;
+    if (!clipAxis(from.y, delta.y, minY[box], maxY[box], enter, exit)) return -1.0f;
+    if (!clipAxis(from.z, delta.z, minZ[box], maxZ[box], enter, exit)) return -1.0f;
+    return enter;
+}
+
+bool CollisionGrid::sweep(Vector3 from, Vector3 to, float& fraction) const {
+    Vector3 delta = Vector3Subtract(to, from);
+    float best = 1.0f;
+    bool hit = false;
+
+    // The ground goes on past the grid
+    if (to.y < groundHeight) {
+        best = from.y > groundHeight ? (from.y - groundHeight) / (from.y - to.y) : 0.0f;
+        hit = true;
+    }
+
+    // Only the part of the segment over the grid can meet a box
+    float enter = 0.0f;
+    float exit = best;
+    if (columns == 0 ||
+        !clipAxis(from.x, delta.x, originX, originX + columns * cellSize, enter, exit) ||
+        !clipAxis(from.z, delta.z, originZ, originZ + rows * cellSize, enter, exit)) {
+        fraction = best;
+        return hit;
+    }
+
+    // Walk the cells the segment crosses, in order (Amanatides & Woo)
+    float startX = from.x + delta.x * enter - originX;
+    float startZ = from.z + delta.z * enter - originZ;
+    int cellX = (int)Clamp(floorf(startX / cellSize), 0.0f, (float)(columns - 1));
+    int cellZ = (int)Clamp(floorf(startZ / cellSize), 0.0f, (float)(rows - 1));
+    int stepX = delta.x > 0.0f ? 1 : -1;
+    int stepZ = delta.z > 0.0f ? 1 : -1;
+    float nextX = FLT_MAX;
+    float nextZ = FLT_MAX;
+    float spanX = FLT_MAX;
+    float spanZ = FLT_MAX;
+    if (fabsf(delta.x) >= 1.0e-8f) {
+        nextX = ((cellX + (stepX > 0 ? 1 : 0)) * cellSize - (from.x - originX)) / delta.x;
+        spanX = cellSize / fabsf(delta.x);
+    }
+    if (fabsf(delta.z) >= 1.0e-8f) {
+        nextZ = ((cellZ + (stepZ > 0 ? 1 : 0)) * cellSize - (from.z - originZ)) / delta.z;
+        spanZ = cellSize / fabsf(delta.z);
+    }
+
+    while (true) {
+        int cell = cellZ * columns + cellX;
+        for (int r = cellStart[cell]; r < cellStart[cell + 1]; r++) {
+            float t = segmentBox(refs[r], from, delta, best);
+            if (t >= 0.0f && t <= best) {
+                best = t;
+                hit = true;
+            }
+        }
+
+        // A hit inside this cell can't be beaten by anything further on
+        float cellExit = fminf(fminf(nextX, nextZ), exit);
+        if ((hit && best <= cellExit) || cellExit >= exit) break;
+        if (nextX < nextZ) {
+            cellX += stepX;
+            if (cellX < 0 || cellX >= columns) break;
+            nextX += spanX;
+        } else {
+            cellZ += stepZ;
+            if (cellZ < 0 || cellZ >= rows) break;
+            nextZ += spanZ;
+        }
+    }
+
+    fraction = best;
+    return hit;
+}
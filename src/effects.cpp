@@ -0,0 +1,138 @@
+#include "effects.h"
+#include <raylib.h>
+#include <raymath.h>
+
+Effects::Effects(int tracerCapacity, int particleCapacity) {
+    maxTracers = tracerCapacity;
+    maxParticles = particleCapacity;
+    stepTime = 0.0f;
+    bulletTracers.reserve(maxTracers);
+    impactParticles.reserve(maxParticles);
+}
+
+void Effects::spawnTracer(Vector3 start, Vector3 end) {
+    if (bulletTracers.size() >= maxTracers) return;
+    
+    // Create brighter, longer-lasting bullet tracer
+    BulletTracer tracer;
+    tracer.start = start;
+    tracer.end = end;
+    tracer.lifetime = 0.15f; // Longer duration
+    tracer.color = (Color){ 255, 255, 0, 255 }; // Bright yellow
+    bulletTracers.push_back(tracer);
+}
+
+void Effects::spawnImpact(Vector3 hitPoint) {
+    // Create more visible impact particles
+    for (int i = 0; i < 15 && impactParticles.size() < maxParticles; i++) {
+        ImpactParticle p;
+        p.position = hitPoint;
+        p.velocity = (Vector3){
+            (float)(GetRandomValue(-200, 200)) / 100.0f,
+            (float)(GetRandomValue(50, 200)) / 100.0f,
+            (float)(GetRandomValue(-200, 200)) / 100.0f
+        };
+        p.lifetime = 0.8f;
+        p.maxLifetime = 0.8f;
+        
+        // Mix of cyan and orange sparks
+        if (i % 2 == 0) {
+            p.color = (Color){ 0, 255, 255, 255 }; // Cyan sparks
+        } else {
+            p.color = (Color){ 255, 150, 0, 255 }; // Orange sparks
+        }
+        impactParticles.push_back(p);
+    }
+}
+
+void Effects::update(float deltaTime) {
+    JobCounter done;
+    beginUpdate(deltaTime, done);
+    JobSystem::instance().wait(done);
+}
+
+void Effects::beginUpdate(float deltaTime, JobCounter& done) {
+    JobSystem& jobs = JobSystem::instance();
+    stepTime = deltaTime;
+    jobs.parallelFor((int)impactParticles.size(), PARTICLE_GRAIN, integrateParticles, this, &integrated);
+    jobs.run(removeExpired, this, 0, 0, &done, &integrated);
+}
+
+void Effects::integrateParticles(void* data, int begin, int end) {
+    Effects& effects = *static_cast<Effects*>(data);
+    float deltaTime = effects.stepTime;
+    ImpactParticle* particles = effects.impactParticles.data();
+    for (int i = begin; i < end; i++) {
+        ImpactParticle& p = particles[i];
+        p.lifetime -= deltaTime;
+        p.position = Vector3Add(p.position, Vector3Scale(p.velocity, deltaTime));
+        p.velocity.y -= 9.8f * deltaTime; // Gravity
+    }
+}
+
+void Effects::removeExpired(void* data, int begin, int end) {
+    (void)begin; (void)end; // One job over every pool
+    Effects& effects = *static_cast<Effects*>(data);
+    float deltaTime = effects.stepTime;
+    
+    // Update bullet tracers (swap-remove keeps the pool allocation-free)
+    std::vector<BulletTracer>& bulletTracers = effects.bulletTracers;
+    for (size_t i = 0; i < bulletTracers.size();) {
+        bulletTracers[i].lifetime -= deltaTime;
+        if (bulletTracers[i].lifetime <= 0.0f) {
+            bulletTracers[i] = bulletTracers.back();
+            bulletTracers.pop_back();
+        } else {
+            ++i;
+        }
+    }
+    
+    // Particles are already integrated; drop the expired ones
+    std::vector<ImpactParticle>& impactParticles = effects.impactParticles;
+    for (size_t i = 0; i < impactParticles.size();) {
+        if (impactParticles[i].lifetime <= 0.0f) {
+            impactParticles[i] = impactParticles.back();
+            impactParticles.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+void Effects::draw() {
+    // Draw bullet tracers
+    for (const auto& tracer : bulletTracers) {
+        float alpha = (tracer.lifetime / 0.15f) * 255.0f;
+        
+        // Draw thick tracer line
+        DrawCylinderEx(tracer.start, tracer.end, 0.02f, 0.02f, 4,
+                      (Color){ tracer.color.r, tracer.color.g, tracer.color.b, (unsigned char)alpha });
+        
+        // Draw bright core
+        DrawLine3D(tracer.start, tracer.end, 
+                  (Color){ 255, 255, 255, (unsigned char)alpha });
+        
+        // Draw glow sphere at start (muzzle)
+        DrawSphere(tracer.start, 0.05f, 
+                  (Color){ 255, 200, 0, (unsigned char)alpha });
+    }
+    
+    // Draw impact particles
+    for (const auto& particle : impactParticles) {
+        float alpha = (particle.lifetime / particle.maxLifetime) * 255.0f;
+        float size = 0.03f + (1.0f - particle.lifetime / particle.maxLifetime) * 0.05f;
+        
+        // Draw particle cube
+        DrawCube(particle.position, size, size, size,
+                (Color){ particle.color.r, particle.color.g, particle.color.b, (unsigned char)alpha });
+        
+        // Draw glow
+        DrawSphere(particle.position, size * 0.5f,
+                  (Color){ particle.color.r, particle.color.g, particle.color.b, (unsigned char)(alpha * 0.5f) });
+    }
+}
+
+void Effects::clear() {
+    bulletTracers.clear();
+    impactParticles.clear();
+}
@@ -0,0 +1,84 @@
+#include "frame_arena.h"
+#include <raylib.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <new>
+
+FrameArena::FrameArena(size_t capacity) {
+    buffer = (unsigned char*)malloc(capacity);
+    bufferSize = buffer ? capacity : 0;
+    offset = 0;
+    peak = 0;
+    overflows = 0;
+    overflowBlocks = nullptr;
+}
+
+FrameArena::~FrameArena() {
+    reset();
+    free(buffer);
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    uintptr_t base = (uintptr_t)buffer;
+    uintptr_t aligned = (base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t newOffset = (aligned - base) + size;
+    
+    if (newOffset <= bufferSize) {
+        offset = newOffset;
+        if (offset > peak) peak = offset;
+        return (void*)aligned;
+    }
+    
+    // Out of arena space: fall back to the heap until the next reset
+    if (overflows == 0) {
+        TraceLog(LOG_WARNING, "FRAME ARENA: %zu byte buffer exhausted, falling back to malloc", bufferSize);
+    }
+    overflows++;
+    size_t header = (sizeof(OverflowBlock) + alignment - 1) & ~(alignment - 1);
+    unsigned char* block = (unsigned char*)malloc(header + size);
+    if (!block) throw std::bad_alloc();
+    OverflowBlock* node = (OverflowBlock*)block;
+    node->next = overflowBlocks;
+    overflowBlocks = node;
+    return block + header;
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list measureArgs;
+    va_copy(measureArgs, args);
+    int length = vsnprintf(nullptr, 0, fmt, measureArgs);
+    va_end(measureArgs);
+    
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+    
+    char* text = allocateArray<char>((size_t)length + 1);
+    vsnprintf(text, (size_t)length + 1, fmt, args);
+    va_end(args);
+    return text;
+}
+
+void FrameArena::reset() {
+#if FRAME_ARENA_POISON
+    if (buffer) memset(buffer, 0xCD, offset);
+#endif
+    offset = 0;
+    
+    while (overflowBlocks) {
+        OverflowBlock* next = overflowBlocks->next;
+        free(overflowBlocks);
+        overflowBlocks = next;
+    }
+}
+
+FrameArena& FrameArena::frame() {
+    static FrameArena arena;
+    return arena;
+}
@@ -0,0 +1,113 @@
+#include "game.h"
+#include <raymath.h>
+
+#if defined(PLATFORM_WEB)
+    #include <GLES2/gl2.h>
+#endif
+
+#include "ui.h"
+#include "voice_manager.h"
+#include "sound_bank.h"
+#include "asset_loader.h"
+#include "alloc_tracker.h"
+#include "action_queue.h"
+#include "account_mirror.h"
+#include "bridge_events.h"
+#include "bridge_latency.h"
+#include "bridge_mailbox.h"
+
+void Game::step(float deltaTime) {
+    ActionQueue& actionQueue = ActionQueue::instance();
+
+    // Other players where they are drawn, for this frame's shots and projectiles
+    AllocTracker::setSubsystem(ALLOC_EFFECTS);
+    hitboxes.fromRoster(roster);
+
+    // The equipped weapon's fire code, compiled for it and picked when it was equipped
+    if (player.isShooting) {
+        ShotContext shot = { &player, &gun, &effects, &projectiles, &map, &hitboxes, &roster,
+                             gun.getMuzzlePosition(player.camera), // Muzzle tip (where muzzle flash appears)
+                             Vector3Normalize(Vector3Subtract(player.camera.target, player.camera.position)) };
+        player.fire(shot);
+        player.isShooting = false;
+    }
+    projectiles.beginStep(deltaTime, mapGrid, &hitboxes, projectilesStepped);
+
+    // Update bullet tracers and impact particles; done by the time we draw
+    effects.beginUpdate(deltaTime, effectsUpdated);
+    VoiceManager::instance().update(); // Voices of finished sounds go back to the pool
+    AssetLoader::instance().update(); // Non-critical assets keep arriving after the loading screen
+    if (audioReady) SoundBank::instance().update();
+
+    // Replicate movement when remote prediction would drift, then send
+    // queued on-chain actions within the in-flight cap
+    AllocTracker::setSubsystem(ALLOC_BRIDGE);
+    BridgeEvents::instance().dispatch(); // Every bridge callback runs here, in order
+
+    // Projectiles that reached a player this step; roster indices still hold until roster.update()
+    JobSystem::instance().wait(projectilesStepped);
+    for (int i = 0; i < projectiles.hitCount(); i++) {
+        const ProjectileHit& hit = projectiles.hit(i);
+        if (hit.player < 0) continue;
+        actionQueue.enqueueApplyDamage(roster.entry(hit.player).entity, hit.weaponSlot, hit.region == HIT_HEAD, hit.distance);
+    }
+    movementSync.update(deltaTime, player.camera.position, player.yaw, player.velocity, player.movementFlags);
+    actionQueue.pump();
+    #if defined(PLATFORM_WEB)
+        BridgeMailboxFlush(); // This frame's bridge calls, in one call into JS
+    #endif
+    AccountMirror::instance().dispatch();
+    roster.update(deltaTime);
+    remoteAudio.update(roster, player.camera.position, player.getRight(), deltaTime);
+    player.updateWeapon(deltaTime);
+
+    AllocTracker::setSubsystem(ALLOC_EFFECTS);
+    JobSystem::instance().wait(effectsUpdated);
+    for (int i = 0; i < projectiles.hitCount(); i++) {
+        effects.spawnImpact(projectiles.hit(i).point);
+    }
+}
+
+void Game::drawScene() {
+    AllocTracker::setSubsystem(ALLOC_RENDER);
+    BeginMode3D(player.camera);
+        // Draw map with fog effect
+        map.draw();
+
+        // Remote players, dead-reckoned from their last Position update
+        roster.draw();
+
+        // Draw bullet tracers and impact particles
+        effects.draw();
+        projectiles.draw();
+
+        // Muzzle flash dynamic lighting - light up the area when shooting
+        gun.drawMuzzleLight(player.camera);
+
+    EndMode3D();
+
+    // Clear depth buffer for gun rendering (so it appears on top)
+    #if defined(PLATFORM_WEB)
+        glClear(GL_DEPTH_BUFFER_BIT);
+    #endif
+
+    // Draw gun in its own 3D context with cleared depth
+    BeginMode3D(player.camera);
+        gun.drawSimple(player.camera);
+    EndMode3D();
+}
+
+void Game::drawHUD(int width, int height) {
+    AllocTracker::setSubsystem(ALLOC_UI);
+    UI::drawCrosshair(width, height);
+    UI::drawGunHUD(player.weaponDef->name, player.ammo, player.maxAmmo, width, height);
+    UI::drawHealthBar(player.health, player.maxHealth, width, height);
+    UI::drawWalletInfo(walletConnected, walletAddress, solBalance);
+    if (showNetworkStats) {
+        UI::drawNetworkStats(ActionQueue::instance().stats(), movementSync.stats(), player.weapon,
+                             BridgeEvents::instance().stats(), width);
+    }
+    if (showBridgeLatency) {
+        UI::drawBridgeLatency(BridgeLatency::instance(), width, height);
+    }
+}
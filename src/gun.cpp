@@ -3,7 +3,9 @@
 #include <raymath.h>
 #include <rlgl.h>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include "voice_manager.h"
 
 Gun::Gun() {
     position = (Vector3){ 0.3f, -0.2f, 0.5f }; // Right side of screen
@@ -12,41 +14,33 @@ Gun::Gun() {
     bobSpeed = 0.0f;
     recoilAngle = 0.0f;
     isRecoiling = false;
+    kickAngle = 0.0f;
+    flashScale = 1.0f;
     sprintTilt = 0.0f;
     sprintOffset = 0.0f;
     sprintSway = 0.0f;
-    currentSoundIndex = 0;
-    
-    // Load gunshot sound - wrap in try-catch for web builds
-    #if defined(PLATFORM_WEB)
-        // For web, the file will be preloaded
-        if (FileExists("assets/gun/audio/submachinegun-gunshot.mp3")) {
-            shootSound = LoadSound("assets/gun/audio/submachinegun-gunshot.mp3");
-            SetSoundVolume(shootSound, 0.5f);
-            
-            // Create multiple instances for overlapping sounds
-            for (int i = 0; i < MAX_SOUND_INSTANCES; i++) {
-                shootSoundInstances[i] = LoadSoundAlias(shootSound);
+    
+    // Decoded once per process, whichever Gun asks first; play waits for it.
+    // Weapons sharing a file share its id, so each file is acquired once.
+    for (int i = 0; i < WEAPON_COUNT; i++) {
+        ownsShootSound[i] = true;
+        for (int j = 0; j < i; j++) {
+            if (strcmp(WEAPONS[i].effect.sound, WEAPONS[j].effect.sound) == 0) {
+                shootSounds[i] = shootSounds[j];
+                ownsShootSound[i] = false;
+                break;
             }
         }
-    #else
-        shootSound = LoadSound("assets/gun/audio/submachinegun-gunshot.mp3");
-        SetSoundVolume(shootSound, 0.5f);
-        
-        // Create multiple instances for overlapping sounds
-        for (int i = 0; i < MAX_SOUND_INSTANCES; i++) {
-            shootSoundInstances[i] = LoadSoundAlias(shootSound);
+        if (ownsShootSound[i]) {
+            shootSounds[i] = SoundBank::instance().acquire(WEAPONS[i].effect.sound, MAX_SOUND_INSTANCES, true);
         }
-    #endif
+    }
 }
 
 Gun::~Gun() {
-    // Cleanup sound instances
-    for (int i = 0; i < MAX_SOUND_INSTANCES; i++) {
-        UnloadSoundAlias(shootSoundInstances[i]);
+    for (int i = 0; i < WEAPON_COUNT; i++) {
+        if (ownsShootSound[i]) SoundBank::instance().release(shootSounds[i]);
     }
-    // Cleanup main sound
-    UnloadSound(shootSound);
 }
 
 void Gun::update(float deltaTime, bool isMoving, bool isShooting, bool isSprinting, bool isCrouching) {
@@ -86,11 +80,7 @@ void Gun::update(float deltaTime, bool isMoving, bool isShooting, bool isSprinti
         sprintSway *= 0.9f; // Fade out
     }
     
-    // Recoil
-    if (isShooting) {
-        applyRecoil();
-    }
-    
+    // Recoil recovery; the kick comes from the weapon's fire code
     if (isRecoiling) {
         recoilAngle -= deltaTime * 12.0f; // Faster recoil recovery (was 8.0f)
         if (recoilAngle <= 0.0f) {
@@ -100,13 +90,48 @@ void Gun::update(float deltaTime, bool isMoving, bool isShooting, bool isSprinti
     }
 }
 
-void Gun::applyRecoil() {
-    recoilAngle = 2.5f; // Lighter kick (was 5.0f)
+void Gun::applyRecoil(float kick, float flashSize, SoundId sound, float volume) {
+    recoilAngle = kick;
+    kickAngle = kick;
+    flashScale = flashSize;
     isRecoiling = true;
     
-    // Play gunshot sound using round-robin to allow overlapping
-    PlaySound(shootSoundInstances[currentSoundIndex]);
-    currentSoundIndex = (currentSoundIndex + 1) % MAX_SOUND_INSTANCES;
+    // Gunshots outrank footsteps when voices run out
+    VoiceManager::instance().play(sound, VOICE_PRIORITY_GUNSHOT, volume);
+}
+
+Vector3 Gun::getMuzzlePosition(Camera3D camera) {
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    Vector3 up = Vector3Normalize(Vector3CrossProduct(right, forward));
+    
+    // Gun barrel position (matches gun rendering position)
+    Vector3 muzzlePos = camera.position;
+    muzzlePos = Vector3Add(muzzlePos, Vector3Scale(right, 0.25f));           // Right
+    muzzlePos = Vector3Add(muzzlePos, Vector3Scale(up, -0.15f));             // Down
+    muzzlePos = Vector3Add(muzzlePos, Vector3Scale(forward, 0.4f + 0.2f + 0.08f)); // Forward + barrel length + muzzle tip
+    return muzzlePos;
+}
+
+void Gun::drawMuzzleLight(Camera3D camera) {
+    if (!isRecoiling || flashIntensity() <= 0.2f) return;
+    
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 muzzlePos = getMuzzlePosition(camera);
+    
+    // Bright spherical light source
+    float lightIntensity = flashIntensity(); // Fades with recoil
+    float lightRadius = (8.0f + lightIntensity * 4.0f) * flashScale; // Dynamic size
+    
+    // Draw multiple light spheres for volumetric effect
+    DrawSphere(muzzlePos, lightRadius, (Color){ 255, 200, 100, 15 });
+    DrawSphere(muzzlePos, lightRadius * 0.7f, (Color){ 255, 220, 150, 25 });
+    DrawSphere(muzzlePos, lightRadius * 0.4f, (Color){ 255, 240, 200, 40 });
+    
+    // Cast light rays in forward direction
+    Vector3 lightEnd = Vector3Add(muzzlePos, Vector3Scale(forward, 15.0f));
+    DrawCylinderEx(muzzlePos, lightEnd, lightRadius * 0.6f, 0.1f, 8,
+                  (Color){ 255, 230, 180, (unsigned char)(20 * lightIntensity) });
 }
 
 void Gun::drawSimple(Camera3D camera) {
@@ -171,21 +196,21 @@ void Gun::drawSimple(Camera3D camera) {
     
     // Enhanced Muzzle Flash (when shooting)
     
-    if (isRecoiling && recoilAngle > 0.5f) {
+    if (isRecoiling && flashIntensity() > 0.2f) {
         // Flash intensity based on recoil (fades out)
-        float intensity = (recoilAngle / 2.5f);
-        float flashScale = 0.7f + (GetRandomValue(0, 30) / 100.0f); // Random size variation (smaller)
+        float intensity = flashIntensity();
+        float flashSize = (0.7f + (GetRandomValue(0, 30) / 100.0f)) * flashScale; // Random size variation, sized per weapon
         
         // Bright white core (hottest part) - reduced size
-        DrawSphere(flashPos, 0.04f * flashScale * intensity, (Color){ 255, 255, 255, 255 });
+        DrawSphere(flashPos, 0.04f * flashSize * intensity, (Color){ 255, 255, 255, 255 });
         
         // Yellow-orange inner glow - reduced size
-        DrawSphere(flashPos, 0.07f * flashScale * intensity, (Color){ 255, 255, 100, 240 });
-        DrawSphere(flashPos, 0.10f * flashScale * intensity, (Color){ 255, 200, 50, 200 });
+        DrawSphere(flashPos, 0.07f * flashSize * intensity, (Color){ 255, 255, 100, 240 });
+        DrawSphere(flashPos, 0.10f * flashSize * intensity, (Color){ 255, 200, 50, 200 });
         
         // Orange-red outer layers - reduced size
-        DrawSphere(flashPos, 0.13f * flashScale * intensity, (Color){ 255, 150, 0, 160 });
-        DrawSphere(flashPos, 0.16f * flashScale * intensity, (Color){ 255, 80, 0, 100 });
+        DrawSphere(flashPos, 0.13f * flashSize * intensity, (Color){ 255, 150, 0, 160 });
+        DrawSphere(flashPos, 0.16f * flashSize * intensity, (Color){ 255, 80, 0, 100 });
         
         // Randomized flash spikes/rays (star pattern) - smaller and fewer
         int numRays = 4;
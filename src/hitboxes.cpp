@@ -0,0 +1,200 @@
+#include "hitboxes.h"
+#include <raymath.h>
+#include <cmath>
+#include "job_system.h"
+
+// Heights above the feet, matching the figure PlayerRoster::draw() puts up
+static const float PLAYER_HEIGHT = 1.8f;       // Eye height, as in Position accounts
+static const float HEAD_DROP = 0.1f;           // Head centre below the eyes
+static const float HEAD_RADIUS = 0.2f;
+static const float BODY_BOTTOM = 0.95f;
+static const float BODY_TOP = 1.35f;
+static const float BODY_RADIUS = 0.25f;
+static const float SHOULDER_HEIGHT = 1.4f;
+static const float SHOULDER_WIDTH = 0.36f;
+static const float HAND_HEIGHT = 1.1f;
+static const float HAND_REACH = 0.3f;          // Forward, holding a weapon
+static const float ARM_RADIUS = 0.08f;
+static const float HIP_HEIGHT = 0.85f;
+static const float HIP_WIDTH = 0.12f;
+static const float ANKLE_HEIGHT = 0.1f;
+static const float LEG_RADIUS = 0.11f;
+static const float BOUND_HEIGHT = 0.95f;       // Centre of a sphere holding every part
+static const float BOUND_RADIUS = 1.05f;
+
+// Distance along a normalized ray to a sphere, or -1 on a miss (or from inside)
+static float raySphere(Vector3 origin, Vector3 direction, float x, float y, float z, float radius) {
+    float ox = origin.x - x;
+    float oy = origin.y - y;
+    float oz = origin.z - z;
+    float b = ox * direction.x + oy * direction.y + oz * direction.z;
+    float c = ox * ox + oy * oy + oz * oz - radius * radius;
+    float h = b * b - c;
+    if (h < 0.0f) return -1.0f;
+    return -b - sqrtf(h);
+}
+
+// Distance along a normalized ray to the capsule around segment a-b, or -1
+static float rayCapsule(Vector3 origin, Vector3 direction, Vector3 a, Vector3 b, float radius) {
+    Vector3 ba = Vector3Subtract(b, a);
+    Vector3 oa = Vector3Subtract(origin, a);
+    float baba = Vector3DotProduct(ba, ba);
+    float bard = Vector3DotProduct(ba, direction);
+    float baoa = Vector3DotProduct(ba, oa);
+    float rdoa = Vector3DotProduct(direction, oa);
+    float oaoa = Vector3DotProduct(oa, oa);
+
+    // Side of the cylinder first, unless the ray runs along the axis
+    float qa = baba - bard * bard;
+    if (qa > 1.0e-6f) {
+        float qb = baba * rdoa - baoa * bard;
+        float qc = baba * oaoa - baoa * baoa - radius * radius * baba;
+        float h = qb * qb - qa * qc;
+        if (h < 0.0f) return -1.0f;
+        float t = (-qb - sqrtf(h)) / qa;
+        float y = baoa + t * bard;
+        if (y > 0.0f && y < baba) return t;
+        // Past an end: the cap on that side
+        return y <= 0.0f ? raySphere(origin, direction, a.x, a.y, a.z, radius)
+                         : raySphere(origin, direction, b.x, b.y, b.z, radius);
+    }
+    float ta = raySphere(origin, direction, a.x, a.y, a.z, radius);
+    float tb = raySphere(origin, direction, b.x, b.y, b.z, radius);
+    if (ta < 0.0f) return tb;
+    if (tb < 0.0f) return ta;
+    return ta < tb ? ta : tb;
+}
+
+Hitboxes::Hitboxes() {
+    players = 0;
+}
+
+void Hitboxes::clear() {
+    players = 0;
+}
+
+bool Hitboxes::add(Vector3 eye, float yaw, int id) {
+    if (players >= MAX_PLAYERS) return false;
+    int i = players++;
+    float feet = eye.y - PLAYER_HEIGHT;
+    float forwardX = cosf(yaw);
+    float forwardZ = sinf(yaw);
+    float rightX = -forwardZ;
+    float rightZ = forwardX;
+
+    ids[i] = id;
+    boundX[i] = eye.x;
+    boundY[i] = feet + BOUND_HEIGHT;
+    boundZ[i] = eye.z;
+    headX[i] = eye.x;
+    headY[i] = eye.y - HEAD_DROP;
+    headZ[i] = eye.z;
+    bodyBottom[i] = feet + BODY_BOTTOM;
+    bodyTop[i] = feet + BODY_TOP;
+
+    // Arms from the shoulders to the hands, then legs from the hips down
+    for (int limb = 0; limb < LIMBS; limb++) {
+        int k = i * LIMBS + limb;
+        float side = (limb & 1) ? 1.0f : -1.0f;
+        if (limb < 2) {
+            limbAX[k] = eye.x + rightX * SHOULDER_WIDTH * side;
+            limbAY[k] = feet + SHOULDER_HEIGHT;
+            limbAZ[k] = eye.z + rightZ * SHOULDER_WIDTH * side;
+            limbBX[k] = limbAX[k] + forwardX * HAND_REACH;
+            limbBY[k] = feet + HAND_HEIGHT;
+            limbBZ[k] = limbAZ[k] + forwardZ * HAND_REACH;
+        } else {
+            limbAX[k] = eye.x + rightX * HIP_WIDTH * side;
+            limbAY[k] = feet + HIP_HEIGHT;
+            limbAZ[k] = eye.z + rightZ * HIP_WIDTH * side;
+            limbBX[k] = limbAX[k];
+            limbBY[k] = feet + ANKLE_HEIGHT;
+            limbBZ[k] = limbAZ[k];
+        }
+    }
+    return true;
+}
+
+void Hitboxes::fromRoster(const PlayerRoster& roster) {
+    clear();
+    for (int i = 0; i < roster.count(); i++) {
+        const RosterEntry& entry = roster.entry(i);
+        if (entry.local || !entry.hasPosition || !entry.alive) continue;
+        add(roster.predictedPosition(entry), entry.rotation, i);
+    }
+}
+
+ShotHit Hitboxes::raycast(Ray ray, float maxDistance, const Map* map) const {
+    ShotHit hit = { HIT_NONE, -1, maxDistance, Vector3Add(ray.position, Vector3Scale(ray.direction, maxDistance)) };
+    Vector3 origin = ray.position;
+    Vector3 direction = ray.direction;
+
+    // Walls first: nothing behind the nearest one can be hit
+    Vector3 wallPoint;
+    if (map && map->raycastWalls(ray, maxDistance, wallPoint)) {
+        hit.region = HIT_WALL;
+        hit.distance = Vector3Distance(origin, wallPoint);
+        hit.point = wallPoint;
+    }
+
+    for (int i = 0; i < players; i++) {
+        // Broad phase: the ray must pass through the player's bounding sphere, in range
+        float cx = boundX[i] - origin.x;
+        float cy = boundY[i] - origin.y;
+        float cz = boundZ[i] - origin.z;
+        float along = cx * direction.x + cy * direction.y + cz * direction.z;
+        float offset = cx * cx + cy * cy + cz * cz - along * along;
+        if (offset > BOUND_RADIUS * BOUND_RADIUS || along + BOUND_RADIUS < 0.0f ||
+            along - BOUND_RADIUS > hit.distance) continue;
+
+        float t = raySphere(origin, direction, headX[i], headY[i], headZ[i], HEAD_RADIUS);
+        if (t >= 0.0f && t < hit.distance) {
+            hit.region = HIT_HEAD;
+            hit.player = ids[i];
+            hit.distance = t;
+        }
+        t = rayCapsule(origin, direction, (Vector3){ headX[i], bodyBottom[i], headZ[i] },
+                       (Vector3){ headX[i], bodyTop[i], headZ[i] }, BODY_RADIUS);
+        if (t >= 0.0f && t < hit.distance) {
+            hit.region = HIT_BODY;
+            hit.player = ids[i];
+            hit.distance = t;
+        }
+        for (int limb = 0; limb < LIMBS; limb++) {
+            int k = i * LIMBS + limb;
+            t = rayCapsule(origin, direction, (Vector3){ limbAX[k], limbAY[k], limbAZ[k] },
+                           (Vector3){ limbBX[k], limbBY[k], limbBZ[k] }, limb < 2 ? ARM_RADIUS : LEG_RADIUS);
+            if (t >= 0.0f && t < hit.distance) {
+                hit.region = HIT_LIMB;
+                hit.player = ids[i];
+                hit.distance = t;
+            }
+        }
+    }
+
+    if (hit.player >= 0) hit.point = Vector3Add(origin, Vector3Scale(direction, hit.distance));
+    return hit;
+}
+
+struct RaycastBatch {
+    const Hitboxes* hitboxes;
+    const Ray* rays;
+    float maxDistance;
+    const Map* map;
+    ShotHit* hits;
+};
+
+void Hitboxes::raycastJob(void* data, int begin, int end) {
+    const RaycastBatch& batch = *static_cast<RaycastBatch*>(data);
+    for (int i = begin; i < end; i++) {
+        batch.hits[i] = batch.hitboxes->raycast(batch.rays[i], batch.maxDistance, batch.map);
+    }
+}
+
+void Hitboxes::raycastBatch(const Ray* rays, int count, float maxDistance, const Map* map, ShotHit* hits) const {
+    RaycastBatch batch = { this, rays, maxDistance, map, hits };
+    JobCounter done;
+    JobSystem& jobs = JobSystem::instance();
+    jobs.parallelFor(count, BATCH_GRAIN, raycastJob, &batch, &done);
+    jobs.wait(done);
+}
@@ -0,0 +1,190 @@
+#include "job_system.h"
+#include <raylib.h>
+
+// Web builds only get workers when compiled with pthreads
+#if !defined(PLATFORM_WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+#define JOB_SYSTEM_THREADS 1
+#else
+#define JOB_SYSTEM_THREADS 0
+#endif
+
+static_assert((JobSystem::QUEUE_SIZE & (JobSystem::QUEUE_SIZE - 1)) == 0, "QUEUE_SIZE must be a power of two");
+
+// 0 on the main thread (and any thread outside the pool), else the worker's queue
+static thread_local int currentThread = 0;
+
+JobSystem& JobSystem::instance() {
+    static JobSystem system;
+    return system;
+}
+
+JobSystem::JobSystem() : queued(0) {
+    for (int i = 0; i <= MAX_WORKERS; i++) {
+        queues[i].front = 0;
+        queues[i].back = 0;
+    }
+    deferredCount = 0;
+    workerCount = 0;
+    stopping = false;
+}
+
+JobSystem::~JobSystem() {
+    stop();
+}
+
+void JobSystem::start() {
+#if JOB_SYSTEM_THREADS
+    if (workerCount > 0) return;
+    unsigned int cores = std::thread::hardware_concurrency();
+    int count = cores > 1 ? (int)cores - 1 : 0;    // The main thread works too
+    if (count > MAX_WORKERS) count = MAX_WORKERS;
+    stopping = false;
+    workerCount = count;    // Before any worker reads it to pick a victim
+    for (int i = 0; i < count; i++) {
+        workers[i] = std::thread(&JobSystem::workerLoop, this, i + 1);
+    }
+    TraceLog(LOG_INFO, "JOBS: %d worker threads", count);
+#endif
+}
+
+void JobSystem::stop() {
+    while (runOne(currentThread)) {}
+    if (workerCount == 0) return;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].join();
+    }
+    workerCount = 0;
+}
+
+void JobSystem::run(JobFunction fn, void* data, int begin, int end, JobCounter* done, JobCounter* after) {
+    Job job = { fn, data, begin, end, done };
+    if (done) done->pending.fetch_add(1, std::memory_order_acq_rel);
+
+    if (after && !after->done()) {
+        std::unique_lock<std::mutex> guard(deferredLock);
+        // Checked again under the lock that execute() takes once `after` hits zero
+        if (!after->done()) {
+            if (deferredCount < MAX_DEFERRED) {
+                deferred[deferredCount].job = job;
+                deferred[deferredCount].after = after;
+                deferredCount++;
+                return;
+            }
+            guard.unlock();
+            wait(*after);
+        }
+    }
+    push(job);
+}
+
+void JobSystem::parallelFor(int count, int grain, JobFunction fn, void* data, JobCounter* done, JobCounter* after) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    int chunks = (count + grain - 1) / grain;
+    if (chunks > threadCount()) chunks = threadCount();
+    int size = (count + chunks - 1) / chunks;
+    for (int begin = 0; begin < count; begin += size) {
+        int end = begin + size < count ? begin + size : count;
+        run(fn, data, begin, end, done, after);
+    }
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    while (!counter.done()) {
+        if (!runOne(currentThread)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::push(const Job& job) {
+    Queue& queue = queues[currentThread];
+    bool stored = false;
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.back - queue.front < (uint32_t)QUEUE_SIZE) {
+            queue.jobs[queue.back & (QUEUE_SIZE - 1)] = job;
+            queue.back++;
+            queued.fetch_add(1, std::memory_order_release);
+            stored = true;
+        }
+    }
+    if (!stored) {
+        execute(job);   // Full: no room to defer it
+        return;
+    }
+    if (workerCount > 0) {
+        { std::lock_guard<std::mutex> guard(sleepLock); }
+        wake.notify_one();
+    }
+}
+
+bool JobSystem::pop(int thread, Job& job) {
+    Queue& queue = queues[thread];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.back == queue.front) return false;
+    queue.back--;
+    job = queue.jobs[queue.back & (QUEUE_SIZE - 1)];
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(int thread, Job& job) {
+    int threads = threadCount();
+    for (int i = 1; i < threads; i++) {
+        Queue& queue = queues[(thread + i) % threads];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.back == queue.front) continue;
+        job = queue.jobs[queue.front & (QUEUE_SIZE - 1)];
+        queue.front++;
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::runOne(int thread) {
+    Job job;
+    if (!pop(thread, job) && !steal(thread, job)) return false;
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const Job& job) {
+    job.fn(job.data, job.begin, job.end);
+    if (!job.done) return;
+
+    // The last one out releases whatever waits on the counter. Counting
+    // down under the lock run() defers under keeps a counter reused at the
+    // same address (the next frame's) from being mistaken for this one.
+    Job ready[MAX_DEFERRED];
+    int readyCount = 0;
+    {
+        std::lock_guard<std::mutex> guard(deferredLock);
+        if (job.done->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        for (int i = 0; i < deferredCount;) {
+            if (deferred[i].after == job.done) {
+                ready[readyCount++] = deferred[i].job;
+                deferred[i] = deferred[--deferredCount];
+            } else {
+                i++;
+            }
+        }
+    }
+    for (int i = 0; i < readyCount; i++) {
+        push(ready[i]);
+    }
+}
+
+void JobSystem::workerLoop(int thread) {
+    currentThread = thread;
+    while (true) {
+        if (runOne(thread)) continue;
+        std::unique_lock<std::mutex> guard(sleepLock);
+        if (stopping) return;
+        wake.wait(guard, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+    }
+}
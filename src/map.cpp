@@ -372,6 +372,28 @@ bool Map::checkCollision(Vector3 playerPos, float playerRadius, Vector3& correct
     return collided;
 }
 
+bool Map::raycastWalls(Ray ray, float maxDistance, Vector3& hitPoint) const {
+    bool hitWall = false;
+    float nearest = maxDistance;
+    
+    // Check collision with each wall in the map
+    for (const auto& wall : walls) {
+        BoundingBox box = {
+            { wall.position.x - wall.size.x/2, wall.position.y - wall.size.y/2, wall.position.z - wall.size.z/2 },
+            { wall.position.x + wall.size.x/2, wall.position.y + wall.size.y/2, wall.position.z + wall.size.z/2 }
+        };
+        RayCollision collision = GetRayCollisionBox(ray, box);
+        
+        if (collision.hit && collision.distance < nearest) {
+            nearest = collision.distance;
+            hitPoint = collision.point;
+            hitWall = true;
+        }
+    }
+    
+    return hitWall;
+}
+
 float Map::getGroundHeight(Vector3 position) {
     // Check if on a platform
     for (const auto& platform : platforms) {
@@ -0,0 +1,660 @@
+#include "mock_chain.h"
+#include "bolt_components.h"
+#include "bridge_events.h"
+#include "bridge_latency.h"
+#include "weapons.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static_assert(MockChain::MAX_PENDING <= BridgeEvents::MAX_SETTLING, "BridgeEvents is sized for at most MAX_SETTLING pending");
+
+// The contract's starting loadout, as the client's weapon table has it
+static const uint32_t PRIMARY_MAGAZINE = WEAPONS[LOADOUT[0]].magazine;
+static const uint32_t SECONDARY_MAGAZINE = WEAPONS[LOADOUT[1]].magazine;
+static const uint32_t PRIMARY_DAMAGE = WEAPONS[LOADOUT[0]].damage;
+static const uint32_t SECONDARY_DAMAGE = WEAPONS[LOADOUT[1]].damage;
+static const uint32_t RESERVE_AMMO = 9000;     // Effectively unlimited, like the client
+static const int64_t RESPAWN_COOLDOWN = 5;     // Seconds, from respawn.json
+static const double BOT_JOG_RADIUS = 3.0;
+static const double BOT_JOG_SPEED = 0.6;       // Radians per second around the spawn point
+
+static double envNumber(const char* name, double fallback) {
+    const char* value = getenv(name);
+    return (value && *value) ? atof(value) : fallback;
+}
+
+MockChainConfig MockChainConfig::defaults() {
+    MockChainConfig config;
+    config.latencyMs = 400.0;   // Roughly one confirmed slot
+    config.jitterMs = 150.0;
+    config.failureRate = 0.0;
+    config.seed = 1;
+    config.botCount = 4;
+    return config;
+}
+
+MockChainConfig MockChainConfig::fromEnvironment() {
+    MockChainConfig config = defaults();
+    config.latencyMs = envNumber("SOLFPS_MOCK_LATENCY_MS", config.latencyMs);
+    config.jitterMs = envNumber("SOLFPS_MOCK_JITTER_MS", config.jitterMs);
+    config.failureRate = envNumber("SOLFPS_MOCK_FAILURE_RATE", config.failureRate);
+    config.seed = (uint32_t)envNumber("SOLFPS_MOCK_SEED", config.seed);
+    config.botCount = (int)envNumber("SOLFPS_MOCK_BOTS", config.botCount);
+    return config;
+}
+
+MockChain& MockChain::instance() {
+    static MockChain chain;
+    return chain;
+}
+
+MockChain::MockChain() {
+    clock = 0.0;
+    currentSlot = 0;
+    accountListener = nullptr;
+    configure(MockChainConfig::fromEnvironment());
+}
+
+void MockChain::configure(const MockChainConfig& config) {
+    settings = config;
+    if (settings.latencyMs < 0.0) settings.latencyMs = 0.0;
+    if (settings.jitterMs < 0.0) settings.jitterMs = 0.0;
+    if (settings.botCount < 0) settings.botCount = 0;
+    if (settings.botCount > MAX_ENTITIES - 1) settings.botCount = MAX_ENTITIES - 1;
+    rngState = settings.seed ? settings.seed : 1;
+    resetState();
+}
+
+static void spawnEntity(MockEntity& entity, int index, uint8_t team) {
+    memset(&entity, 0, sizeof(entity));
+    if (index == MockChain::LOCAL_PLAYER) {
+        snprintf(entity.address, sizeof(entity.address), "mock-local-player");
+    } else {
+        snprintf(entity.address, sizeof(entity.address), "mock-bot-%d", index);
+    }
+
+    entity.player.hasLoggedIn = true;
+    entity.player.team = team;
+    entity.player.inGame = true;
+    entity.player.isAlive = true;
+    entity.player.level = 1;
+
+    // Spread spawns around the arena center
+    double angle = index * 0.9;
+    entity.position.x = index == MockChain::LOCAL_PLAYER ? 0.0 : 20.0 * cos(angle);
+    entity.position.y = 1.8;
+    entity.position.z = index == MockChain::LOCAL_PLAYER ? 5.0 : 20.0 * sin(angle);
+    entity.position.spawnPointId = (uint8_t)index;
+
+    entity.health.maxHp = 100;
+    entity.health.currentHp = 100;
+    entity.health.maxArmor = 50;
+    entity.health.isAlive = true;
+
+    entity.weapon.currentWeapon = 1;
+    entity.weapon.primaryAmmo = PRIMARY_MAGAZINE;
+    entity.weapon.primaryAmmoReserve = RESERVE_AMMO;
+    entity.weapon.secondaryAmmo = SECONDARY_MAGAZINE;
+    entity.weapon.secondaryAmmoReserve = RESERVE_AMMO;
+    entity.weapon.primaryDamage = PRIMARY_DAMAGE;
+    entity.weapon.secondaryDamage = SECONDARY_DAMAGE;
+    entity.weapon.canSwitchWeapon = true;
+}
+
+void MockChain::resetState() {
+    currentSlot++;   // Never goes backwards, so subscribers take the new world over the old one
+    sequence = 0;
+    pending = 0;
+    lastFeedTick = clock;
+    memset(queue, 0, sizeof(queue));
+    memset(&totals, 0, sizeof(totals));
+
+    // Local player on team A against bots on team B, match already running
+    entities = 1 + settings.botCount;
+    for (int i = 0; i < entities; i++) {
+        spawnEntity(world[i], i, i == LOCAL_PLAYER ? 0 : 1);
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.matchDuration = 600;
+    state.gameState = GAME_IN_PROGRESS;
+    state.matchStartTimestamp = (int64_t)clock;
+    state.maxPlayersPerTeam = 5;
+    state.currentPlayersTeamA = 1;
+    state.currentPlayersTeamB = (uint8_t)settings.botCount;
+
+    if (accountListener) publishAccounts(true);
+}
+
+int MockChain::findEntity(const char* address) const {
+    if (!address) return -1;
+    for (int i = 0; i < entities; i++) {
+        if (strcmp(world[i].address, address) == 0) return i;
+    }
+    return -1;
+}
+
+// xorshift64*, kept separate from raylib's RNG so gameplay randomness
+// doesn't shift with network timing
+double MockChain::nextRandom() {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (double)((rngState * 2685821657736338717ULL) >> 11) / 9007199254740992.0;
+}
+
+MockChain::PendingTransaction* MockChain::reserve(uint8_t instruction, NativeBridgeCallback callback) {
+    totals.submitted++;
+    if (pending == MAX_PENDING) {
+        totals.backlogFull++;
+        double now = BridgeLatency::now();
+        BridgeEvents::instance().post(instruction, callback, now, now, "Mock chain backlog full");
+        return nullptr;
+    }
+    for (int i = 0; i < MAX_PENDING; i++) {
+        PendingTransaction& transaction = queue[i];
+        if (transaction.active) continue;
+        transaction.active = true;
+        transaction.instruction = instruction;
+        transaction.sequence = sequence++;
+        transaction.submittedAt = BridgeLatency::now();
+        transaction.readyAt = clock + (settings.latencyMs + settings.jitterMs * nextRandom()) / 1000.0;
+        transaction.count = 0;
+        transaction.executed = false;
+        transaction.error = nullptr;
+        transaction.callback = callback;
+        pending++;
+        return &transaction;
+    }
+    return nullptr;
+}
+
+void MockChain::submit(const BridgeRequest& request, NativeBridgeCallback callback) {
+    submitTransaction(&request, 1, request.instruction, callback);
+}
+
+void MockChain::submitBatch(const BridgeRequest* requests, int count, NativeBridgeCallback callback) {
+    submitTransaction(requests, count, BRIDGE_EXECUTE_BATCH, callback);
+}
+
+void MockChain::submitTransaction(const BridgeRequest* requests, int count, uint8_t instruction,
+                                  NativeBridgeCallback callback) {
+    if (count < 1 || count > MAX_BATCH_ACTIONS) {
+        double now = BridgeLatency::now();
+        BridgeEvents::instance().post(instruction, callback, now, now, "Invalid arguments");
+        return;
+    }
+    PendingTransaction* transaction = reserve(instruction, callback);
+    if (!transaction) return;
+
+    // Copy strings into the slot; the caller's memory is gone by the time this lands
+    transaction->count = count;
+    for (int i = 0; i < count; i++) {
+        transaction->requests[i] = requests[i];
+        transaction->addresses[i][0] = '\0';
+        if (requests[i].address) {
+            strncpy(transaction->addresses[i], requests[i].address, MockEntity::ADDRESS_SIZE - 1);
+            transaction->addresses[i][MockEntity::ADDRESS_SIZE - 1] = '\0';
+        }
+        transaction->requests[i].address = transaction->addresses[i];
+    }
+}
+
+int MockChain::poll(double now) {
+    if (now > clock) clock = now;
+
+    // Bots respawn on their own once the cooldown is over
+    for (int i = 0; i < entities; i++) {
+        if (i == LOCAL_PLAYER || world[i].health.isAlive) continue;
+        if ((int64_t)clock - world[i].health.lastDamageTimestamp >= RESPAWN_COOLDOWN) {
+            MockPlayerStats stats = world[i].stats;
+            spawnEntity(world[i], i, world[i].player.team);
+            world[i].stats = stats;
+            currentSlot++;
+        }
+    }
+
+    if (clock - lastFeedTick >= FEED_INTERVAL) {
+        lastFeedTick = clock;
+        moveBots();
+        if (accountListener) publishAccounts(false);
+    }
+
+    // Land due transactions in readyAt order; their callbacks run from the
+    // next BridgeEvents::dispatch, so a zero-latency chain can't spin.
+    uint64_t cutoff = sequence;
+    int delivered = 0;
+    while (true) {
+        PendingTransaction* next = nullptr;
+        for (int i = 0; i < MAX_PENDING; i++) {
+            PendingTransaction& transaction = queue[i];
+            if (!transaction.active || transaction.sequence >= cutoff || transaction.readyAt > clock) continue;
+            if (!next || transaction.readyAt < next->readyAt) next = &transaction;
+        }
+        if (!next) break;
+
+        if (!next->executed) {
+            if (settings.failureRate > 0.0 && nextRandom() < settings.failureRate) {
+                next->error = "Transaction dropped (injected failure)";
+                totals.injectedFailures++;
+            } else {
+                next->error = execute(*next);
+                if (next->error) totals.failed++;
+                else totals.confirmed++;
+            }
+            next->executed = true;
+        }
+
+        // A full event queue leaves it landed but pending, to post again next poll
+        if (!BridgeEvents::instance().post(next->instruction, next->callback, next->submittedAt, BridgeLatency::now(),
+                                           next->error)) {
+            break;
+        }
+        next->active = false;
+        pending--;
+        delivered++;
+    }
+    return delivered;
+}
+
+// All instructions in a transaction land or none do
+const char* MockChain::execute(const PendingTransaction& transaction) {
+    MockEntity worldBefore[MAX_ENTITIES];
+    memcpy(worldBefore, world, sizeof(MockEntity) * entities);
+    MockGame stateBefore = state;
+
+    for (int i = 0; i < transaction.count; i++) {
+        const char* error = apply(transaction.requests[i]);
+        if (error) {
+            memcpy(world, worldBefore, sizeof(MockEntity) * entities);
+            state = stateBefore;
+            return error;
+        }
+    }
+    currentSlot++;
+    return nullptr;
+}
+
+static uint32_t* magazineFor(MockWeapon& weapon, uint8_t slot) {
+    return slot == 1 ? &weapon.primaryAmmo : &weapon.secondaryAmmo;
+}
+
+// Checks and effects follow the error lists in idl/*.json
+const char* MockChain::apply(const BridgeRequest& request) {
+    MockEntity& self = world[LOCAL_PLAYER];
+    int64_t timestamp = (int64_t)clock;
+
+    switch (request.instruction) {
+        case BRIDGE_INIT_PLAYER:
+            if (self.player.hasLoggedIn) return "Player is already logged in";
+            spawnEntity(self, LOCAL_PLAYER, 0);
+            self.player.inGame = false;
+            return nullptr;
+
+        case BRIDGE_INIT_GAME:
+            if (!self.player.hasLoggedIn) return "Player must be registered to create a game";
+            if (self.player.inGame) return "Player is already in a game";
+            // A fresh lobby with only the creator in it
+            for (int i = 0; i < entities; i++) {
+                if (i != LOCAL_PLAYER) world[i].player.inGame = false;
+            }
+            memset(&state, 0, sizeof(state));
+            state.matchDuration = 600;
+            state.gameState = GAME_WAITING;
+            state.maxPlayersPerTeam = 5;
+            state.currentPlayersTeamA = 1;
+            self.player.inGame = true;
+            self.player.team = 0;
+            self.player.isReady = false;
+            return nullptr;
+
+        case BRIDGE_JOIN_GAME:
+            if (!self.player.hasLoggedIn) return "Player is not registered";
+            if (self.player.inGame) return "Player is already in a game";
+            if (state.gameState != GAME_WAITING) return "Game has already started";
+            if (state.currentPlayersTeamA >= state.maxPlayersPerTeam &&
+                state.currentPlayersTeamB >= state.maxPlayersPerTeam) return "Game is full";
+            self.player.inGame = true;
+            self.player.team = state.currentPlayersTeamA <= state.currentPlayersTeamB ? 0 : 1;
+            if (self.player.team == 0) state.currentPlayersTeamA++;
+            else state.currentPlayersTeamB++;
+            return nullptr;
+
+        case BRIDGE_LEAVE_GAME:
+            if (!self.player.inGame) return "Player is not currently in a game";
+            if (self.player.team == 0 && state.currentPlayersTeamA > 0) state.currentPlayersTeamA--;
+            if (self.player.team == 1 && state.currentPlayersTeamB > 0) state.currentPlayersTeamB--;
+            if (self.player.isReady && state.readyPlayers > 0) state.readyPlayers--;
+            self.player.inGame = false;
+            self.player.isReady = false;
+            return nullptr;
+
+        case BRIDGE_SET_READY:
+            if (!self.player.hasLoggedIn) return "Player is not registered";
+            if (!self.player.inGame) return "Player is not in a game";
+            if (state.gameState != GAME_WAITING) return "Game has already started";
+            if (request.flag && !self.player.isReady) state.readyPlayers++;
+            if (!request.flag && self.player.isReady && state.readyPlayers > 0) state.readyPlayers--;
+            self.player.isReady = request.flag != 0;
+            return nullptr;
+
+        case BRIDGE_START_GAME:
+            if (state.gameState != GAME_WAITING) return "Game has already started";
+            if (!self.player.inGame) return "Cannot start game - need lobby leader or 10 players";
+            if (state.currentPlayersTeamA + state.currentPlayersTeamB < 2) return "Not enough players to start game";
+            state.gameState = GAME_IN_PROGRESS;
+            state.matchStartTimestamp = timestamp;
+            self.player.totalMatchesPlayed++;
+            return nullptr;
+
+        case BRIDGE_END_GAME:
+            if (state.gameState != GAME_IN_PROGRESS) return "Game is not currently in progress";
+            state.gameState = GAME_ENDED;
+            state.matchEndTimestamp = timestamp;
+            return nullptr;
+
+        case BRIDGE_UPDATE_MOVEMENT: {
+            if (!self.health.isAlive) return "Player is not alive";
+            for (int i = 0; i < 7; i++) {
+                if (!std::isfinite(request.args[i])) return "Invalid movement input";
+            }
+            MockPosition& position = self.position;
+            position.x = request.args[0];
+            position.y = request.args[1];
+            position.z = request.args[2];
+            position.rotationY = request.args[3];
+            position.velocityX = request.args[4];
+            position.velocityY = request.args[5];
+            position.velocityZ = request.args[6];
+            position.isMoving = position.velocityX != 0.0f || position.velocityZ != 0.0f;
+            position.isJumping = position.velocityY > 0.0f;
+            return nullptr;
+        }
+
+        case BRIDGE_SHOOT: {
+            if (request.weaponSlot != 1 && request.weaponSlot != 2) return "Invalid weapon slot";
+            if (!self.health.isAlive) return "Player is not alive";
+            if (!self.player.inGame) return "Player is not in a game";
+            if (self.weapon.isReloading) return "Weapon is currently reloading";
+            uint32_t* magazine = magazineFor(self.weapon, request.weaponSlot);
+            if (*magazine == 0) return "No ammo remaining";
+            (*magazine)--;
+            self.weapon.lastShotTimestamp = timestamp;
+            return nullptr;
+        }
+
+        case BRIDGE_RELOAD: {
+            if (request.weaponSlot != 1 && request.weaponSlot != 2) return "Invalid weapon slot";
+            if (!self.health.isAlive) return "Player is not alive";
+            if (self.weapon.isReloading) return "Reload already in progress";
+            uint32_t* magazine = magazineFor(self.weapon, request.weaponSlot);
+            uint32_t* reserve = request.weaponSlot == 1 ? &self.weapon.primaryAmmoReserve : &self.weapon.secondaryAmmoReserve;
+            uint32_t capacity = request.weaponSlot == 1 ? PRIMARY_MAGAZINE : SECONDARY_MAGAZINE;
+            if (*magazine >= capacity || *reserve == 0) return "Weapon is full or no reserve ammo";
+            uint32_t moved = capacity - *magazine;
+            if (moved > *reserve) moved = *reserve;
+            *magazine += moved;
+            *reserve -= moved;
+            return nullptr;
+        }
+
+        case BRIDGE_SWITCH_WEAPON:
+            if (request.weaponSlot != 1 && request.weaponSlot != 2) return "Invalid weapon slot";
+            if (!self.weapon.canSwitchWeapon) return "Cannot switch weapon";
+            self.weapon.currentWeapon = request.weaponSlot;
+            return nullptr;
+
+        case BRIDGE_APPLY_DAMAGE: {
+            if (request.weaponSlot != 1 && request.weaponSlot != 2) return "Invalid weapon type";
+            if (!self.player.inGame) return "Attacker is not in a game";
+            int victimIndex = findEntity(request.address);
+            if (victimIndex < 0 || !world[victimIndex].player.inGame) return "Victim is not in a game";
+            MockEntity& victim = world[victimIndex];
+            if (!victim.health.isAlive) return "Victim is already dead";
+            if (victim.player.team == self.player.team) return "Cannot damage teammates";
+
+            uint32_t damage = request.weaponSlot == 1 ? self.weapon.primaryDamage : self.weapon.secondaryDamage;
+            if (request.isHeadshot) damage *= 2;
+            if (damage > victim.health.currentHp) damage = victim.health.currentHp;
+
+            victim.health.currentHp -= damage;
+            victim.health.lastDamageTimestamp = timestamp;
+            victim.health.lastDamageAmount = damage;
+            victim.stats.damageTaken += damage;
+            self.stats.damageDealt += damage;
+
+            if (victim.health.currentHp == 0) {
+                victim.health.isAlive = false;
+                victim.player.isAlive = false;
+                victim.stats.deaths++;
+                victim.stats.killStreak = 0;
+                self.stats.kills++;
+                self.stats.killStreak++;
+                if (self.stats.killStreak > self.stats.highestKillStreak) self.stats.highestKillStreak = self.stats.killStreak;
+                if (request.isHeadshot) self.stats.headshots++;
+                if (self.player.team == 0) state.teamAScore++;
+                else state.teamBScore++;
+            }
+            self.stats.kdaRatio = (float)(self.stats.kills + self.stats.assists) /
+                                  (float)(self.stats.deaths > 0 ? self.stats.deaths : 1);
+            return nullptr;
+        }
+
+        case BRIDGE_RESPAWN: {
+            if (!self.player.hasLoggedIn) return "Player is not logged in";
+            if (!self.player.inGame) return "Player is not in a game";
+            if (self.health.isAlive) return "Player is already alive";
+            if (timestamp - self.health.lastDamageTimestamp < RESPAWN_COOLDOWN) return "Must wait 5 seconds before respawning";
+            MockPlayerStats stats = self.stats;
+            MockPlayer player = self.player;
+            spawnEntity(self, LOCAL_PLAYER, player.team);
+            self.stats = stats;
+            self.player = player;
+            self.player.isAlive = true;
+            return nullptr;
+        }
+
+        default:
+            return "Invalid arguments";
+    }
+}
+
+// Bots jog in a small circle around their spawn point, as if each sent a
+// movement transaction every feed tick
+void MockChain::moveBots() {
+    bool moved = false;
+    for (int i = 0; i < entities; i++) {
+        if (i == LOCAL_PLAYER || !world[i].health.isAlive) continue;
+        double spawnAngle = i * 0.9;
+        double phase = clock * BOT_JOG_SPEED + i;
+        MockPosition& position = world[i].position;
+        position.x = 20.0 * cos(spawnAngle) + BOT_JOG_RADIUS * cos(phase);
+        position.z = 20.0 * sin(spawnAngle) + BOT_JOG_RADIUS * sin(phase);
+        position.velocityX = (float)(-BOT_JOG_RADIUS * BOT_JOG_SPEED * sin(phase));
+        position.velocityZ = (float)(BOT_JOG_RADIUS * BOT_JOG_SPEED * cos(phase));
+        position.rotationY = (float)atan2(position.velocityZ, position.velocityX);   // Yaw, as Player: forward = (cos, sin)
+        position.isMoving = true;
+        moved = true;
+    }
+    if (moved) currentSlot++;
+}
+
+void MockChain::setAccountListener(MockAccountListener listener) {
+    accountListener = listener;
+    if (accountListener) publishAccounts(true);
+}
+
+template <typename Component>
+static void publish(MockAccountListener listener, const char* entity, const char* component,
+                    uint64_t slot, const Component& value) {
+    uint8_t data[512];
+    borsh::Writer writer(data, sizeof(data));
+    bolt::encodeAccount(writer, value);
+    if (writer.overflowed()) return;
+
+    char address[MockEntity::ADDRESS_SIZE + 16];
+    snprintf(address, sizeof(address), "%s/%s", entity, component);
+    listener(address, entity, slot, data, writer.size());
+}
+
+static bolt::Position toComponent(const MockPosition& mock) {
+    bolt::Position position = {};
+    position.x = mock.x;
+    position.y = mock.y;
+    position.z = mock.z;
+    position.rotationX = mock.rotationX;
+    position.rotationY = mock.rotationY;
+    position.velocityX = mock.velocityX;
+    position.velocityY = mock.velocityY;
+    position.velocityZ = mock.velocityZ;
+    position.isJumping = mock.isJumping;
+    position.isMoving = mock.isMoving;
+    position.spawnPointId = mock.spawnPointId;
+    return position;
+}
+
+static bolt::Health toComponent(const MockHealth& mock) {
+    bolt::Health health = {};
+    health.maxHp = mock.maxHp;
+    health.currentHp = mock.currentHp;
+    health.armor = mock.armor;
+    health.maxArmor = mock.maxArmor;
+    health.isAlive = mock.isAlive;
+    health.lastDamageTimestamp = mock.lastDamageTimestamp;
+    health.lastDamageAmount = mock.lastDamageAmount;
+    return health;
+}
+
+static bolt::Weapon toComponent(const MockWeapon& mock) {
+    bolt::Weapon weapon = {};
+    weapon.currentWeapon = mock.currentWeapon;
+    weapon.primaryAmmo = mock.primaryAmmo;
+    weapon.primaryAmmoReserve = mock.primaryAmmoReserve;
+    weapon.secondaryAmmo = mock.secondaryAmmo;
+    weapon.secondaryAmmoReserve = mock.secondaryAmmoReserve;
+    weapon.primaryDamage = mock.primaryDamage;
+    weapon.secondaryDamage = mock.secondaryDamage;
+    weapon.canSwitchWeapon = mock.canSwitchWeapon;
+    weapon.reloadTime = mock.reloadTime;
+    weapon.lastShotTimestamp = mock.lastShotTimestamp;
+    weapon.isReloading = mock.isReloading;
+    return weapon;
+}
+
+static bolt::PlayerStats toComponent(const MockPlayerStats& mock) {
+    bolt::PlayerStats stats = {};
+    stats.kills = mock.kills;
+    stats.deaths = mock.deaths;
+    stats.assists = mock.assists;
+    stats.headshots = mock.headshots;
+    stats.damageTaken = mock.damageTaken;
+    stats.damageDealt = mock.damageDealt;
+    stats.roundWins = mock.roundWins;
+    stats.kdaRatio = mock.kdaRatio;
+    stats.killStreak = mock.killStreak;
+    stats.highestKillStreak = mock.highestKillStreak;
+    return stats;
+}
+
+static bolt::Player toComponent(const MockPlayer& mock, const char* username) {
+    bolt::Player player = {};
+    player.username = username;
+    player.hasLoggedIn = mock.hasLoggedIn;
+    player.team = mock.team;
+    if (mock.inGame) player.currentGame = bolt::Pubkey{};
+    player.isAlive = mock.isAlive;
+    player.totalMatchesPlayed = mock.totalMatchesPlayed;
+    player.level = mock.level;
+    player.isReady = mock.isReady;
+    return player;
+}
+
+static bolt::Game toComponent(const MockGame& mock) {
+    bolt::Game game = {};
+    game.teamAScore = mock.teamAScore;
+    game.teamBScore = mock.teamBScore;
+    game.matchDuration = mock.matchDuration;
+    game.matchStartTimestamp = mock.matchStartTimestamp;
+    if (mock.gameState == MockChain::GAME_ENDED) game.matchEndTimestamp = mock.matchEndTimestamp;
+    game.gameState = mock.gameState;
+    game.maxPlayersPerTeam = mock.maxPlayersPerTeam;
+    game.currentPlayersTeamA = mock.currentPlayersTeamA;
+    game.currentPlayersTeamB = mock.currentPlayersTeamB;
+    game.mapName = "arena";
+    game.readyPlayers = mock.readyPlayers;
+    return game;
+}
+
+// Components are compared field-wise rather than with memcmp: struct
+// assignment doesn't promise to copy padding
+static bool same(const MockPosition& a, const MockPosition& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.rotationX == b.rotationX && a.rotationY == b.rotationY &&
+           a.velocityX == b.velocityX && a.velocityY == b.velocityY && a.velocityZ == b.velocityZ &&
+           a.isJumping == b.isJumping && a.isMoving == b.isMoving && a.spawnPointId == b.spawnPointId;
+}
+
+static bool same(const MockHealth& a, const MockHealth& b) {
+    return a.maxHp == b.maxHp && a.currentHp == b.currentHp && a.armor == b.armor && a.maxArmor == b.maxArmor &&
+           a.isAlive == b.isAlive && a.lastDamageTimestamp == b.lastDamageTimestamp &&
+           a.lastDamageAmount == b.lastDamageAmount;
+}
+
+static bool same(const MockWeapon& a, const MockWeapon& b) {
+    return a.currentWeapon == b.currentWeapon && a.primaryAmmo == b.primaryAmmo &&
+           a.primaryAmmoReserve == b.primaryAmmoReserve && a.secondaryAmmo == b.secondaryAmmo &&
+           a.secondaryAmmoReserve == b.secondaryAmmoReserve && a.primaryDamage == b.primaryDamage &&
+           a.secondaryDamage == b.secondaryDamage && a.canSwitchWeapon == b.canSwitchWeapon &&
+           a.reloadTime == b.reloadTime && a.lastShotTimestamp == b.lastShotTimestamp && a.isReloading == b.isReloading;
+}
+
+static bool same(const MockPlayer& a, const MockPlayer& b) {
+    return a.hasLoggedIn == b.hasLoggedIn && a.team == b.team && a.inGame == b.inGame && a.isAlive == b.isAlive &&
+           a.totalMatchesPlayed == b.totalMatchesPlayed && a.level == b.level && a.isReady == b.isReady;
+}
+
+static bool same(const MockPlayerStats& a, const MockPlayerStats& b) {
+    return a.kills == b.kills && a.deaths == b.deaths && a.assists == b.assists && a.headshots == b.headshots &&
+           a.damageTaken == b.damageTaken && a.damageDealt == b.damageDealt && a.roundWins == b.roundWins &&
+           a.kdaRatio == b.kdaRatio && a.killStreak == b.killStreak && a.highestKillStreak == b.highestKillStreak;
+}
+
+static bool same(const MockGame& a, const MockGame& b) {
+    return a.teamAScore == b.teamAScore && a.teamBScore == b.teamBScore && a.matchDuration == b.matchDuration &&
+           a.matchStartTimestamp == b.matchStartTimestamp && a.matchEndTimestamp == b.matchEndTimestamp &&
+           a.gameState == b.gameState && a.maxPlayersPerTeam == b.maxPlayersPerTeam &&
+           a.currentPlayersTeamA == b.currentPlayersTeamA && a.currentPlayersTeamB == b.currentPlayersTeamB &&
+           a.readyPlayers == b.readyPlayers;
+}
+
+// Pushes every component that differs from what the listener last saw
+void MockChain::publishAccounts(bool everything) {
+    for (int i = 0; i < entities; i++) {
+        const MockEntity& current = world[i];
+        const MockEntity& seen = published[i];
+        const char* entity = current.address;
+
+        if (everything || !same(current.position, seen.position)) {
+            publish(accountListener, entity, "position", currentSlot, toComponent(current.position));
+        }
+        if (everything || !same(current.health, seen.health)) {
+            publish(accountListener, entity, "health", currentSlot, toComponent(current.health));
+        }
+        if (everything || !same(current.weapon, seen.weapon)) {
+            publish(accountListener, entity, "weapon", currentSlot, toComponent(current.weapon));
+        }
+        if (everything || !same(current.player, seen.player)) {
+            publish(accountListener, entity, "player", currentSlot, toComponent(current.player, entity));
+        }
+        if (everything || !same(current.stats, seen.stats)) {
+            publish(accountListener, entity, "stats", currentSlot, toComponent(current.stats));
+        }
+        published[i] = current;
+    }
+
+    if (everything || !same(state, publishedGame)) {
+        publish(accountListener, "mock-game", "game", currentSlot, toComponent(state));
+    }
+    publishedGame = state;
+}
@@ -0,0 +1,84 @@
+#include "movement_sync.h"
+#include <raymath.h>
+#include <cmath>
+#include "action_queue.h"
+
+MovementSync::MovementSync() {
+    tickInterval = 1.0f / DEFAULT_TICK_RATE;
+    positionThreshold = DEFAULT_POSITION_THRESHOLD;
+    angleThreshold = DEFAULT_ANGLE_THRESHOLD;
+    heartbeat = DEFAULT_HEARTBEAT;
+    tickTimer = 0.0f;
+    counters = (MovementSyncStats){ 0, 0, 0.0f };
+    reset();
+}
+
+void MovementSync::setTickRate(float hz) {
+    tickInterval = hz > 0.0f ? 1.0f / hz : 1.0f / DEFAULT_TICK_RATE;
+}
+
+void MovementSync::setThresholds(float position, float angle) {
+    positionThreshold = position;
+    angleThreshold = angle;
+}
+
+void MovementSync::setHeartbeat(float seconds) {
+    heartbeat = seconds;
+}
+
+void MovementSync::reset() {
+    hasSent = false;
+    sentPosition = (Vector3){ 0.0f, 0.0f, 0.0f };
+    sentVelocity = (Vector3){ 0.0f, 0.0f, 0.0f };
+    sentRotation = 0.0f;
+    sentFlags = 0;
+    timeSinceSend = 0.0f;
+}
+
+bool MovementSync::needsUpdate(Vector3 position, float rotation, uint8_t flags) const {
+    if (!hasSent) return true;
+    if (flags != sentFlags) return true;
+    if (heartbeat > 0.0f && timeSinceSend >= heartbeat) return true;
+
+    // Where remote clients think we are right now
+    Vector3 predicted = Vector3Add(sentPosition, Vector3Scale(sentVelocity, timeSinceSend));
+    if (Vector3DistanceSqr(predicted, position) > positionThreshold * positionThreshold) return true;
+
+    // Shortest angle between the sent and current rotation
+    float angle = fmodf(rotation - sentRotation, 2.0f * PI);
+    if (angle > PI) angle -= 2.0f * PI;
+    if (angle < -PI) angle += 2.0f * PI;
+    return fabsf(angle) > angleThreshold;
+}
+
+void MovementSync::update(float deltaTime, Vector3 position, float rotation, Vector3 velocity, uint8_t flags) {
+    ActionQueue& queue = ActionQueue::instance();
+    if (!queue.isEnabled()) {
+        // Nobody is receiving; send a fresh state once the queue comes back
+        hasSent = false;
+        return;
+    }
+
+    timeSinceSend += deltaTime;
+    tickTimer += deltaTime;
+    if (tickTimer < tickInterval) return;
+    tickTimer = fmodf(tickTimer, tickInterval);
+    counters.ticks++;
+
+    if (hasSent) {
+        Vector3 predicted = Vector3Add(sentPosition, Vector3Scale(sentVelocity, timeSinceSend));
+        counters.lastError = Vector3Distance(predicted, position);
+    }
+    if (!needsUpdate(position, rotation, flags)) return;
+
+    // Only remember the state if it actually made it into the queue
+    if (queue.enqueueMovement(position, rotation, velocity)) {
+        hasSent = true;
+        sentPosition = position;
+        sentVelocity = velocity;
+        sentRotation = rotation;
+        sentFlags = flags;
+        timeSinceSend = 0.0f;
+        counters.sent++;
+    }
+}
@@ -0,0 +1,80 @@
+#include "native_bridge.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "bridge_events.h"
+#include "bridge_latency.h"
+#include "execute_batch.h"
+#include "mock_chain.h"
+
+static bool bridgeEnabled = false;
+static bool bridgeResolved = false;
+
+bool NativeBridgeEnabled(void) {
+    if (!bridgeResolved) {
+        const char* value = getenv("SOLFPS_MOCK_CHAIN");
+        bridgeEnabled = value && *value && strcmp(value, "0") != 0;
+        bridgeResolved = true;
+    }
+    return bridgeEnabled;
+}
+
+void NativeBridgeSetEnabled(bool enabled) {
+    bridgeEnabled = enabled;
+    bridgeResolved = true;
+}
+
+static void reject(uint8_t instruction, NativeBridgeCallback callback, const char* error) {
+    double now = BridgeLatency::now();
+    BridgeEvents::instance().post(instruction, callback, now, now, error);
+}
+
+void NativeBridgeSubmit(const BridgeRequest* request, NativeBridgeCallback callback) {
+    if (!NativeBridgeEnabled()) {
+        reject(request->instruction, callback, "Web platform only");
+        return;
+    }
+    MockChain::instance().submit(*request, callback);
+}
+
+void NativeBridgeSubmitBatch(const struct BatchAction* actions, int count, NativeBridgeCallback callback) {
+    if (!NativeBridgeEnabled()) {
+        reject(BRIDGE_EXECUTE_BATCH, callback, "Web platform only");
+        return;
+    }
+    if (count < 1 || count > MockChain::MAX_BATCH_ACTIONS) {
+        reject(BRIDGE_EXECUTE_BATCH, callback, "Invalid arguments");
+        return;
+    }
+
+    static const uint8_t instructionFor[] = {
+        BRIDGE_UPDATE_MOVEMENT,   // BATCH_ACTION_MOVEMENT
+        BRIDGE_SHOOT,             // BATCH_ACTION_SHOOT
+        BRIDGE_RELOAD,            // BATCH_ACTION_RELOAD
+        BRIDGE_SWITCH_WEAPON,     // BATCH_ACTION_SWITCH_WEAPON
+        BRIDGE_APPLY_DAMAGE       // BATCH_ACTION_APPLY_DAMAGE
+    };
+
+    BridgeRequest requests[MockChain::MAX_BATCH_ACTIONS];
+    for (int i = 0; i < count; i++) {
+        const BatchAction& action = actions[i];
+        BridgeRequest& request = requests[i];
+        memset(&request, 0, sizeof(request));
+        request.instruction = action.type <= BATCH_ACTION_APPLY_DAMAGE ? (BridgeInstruction)instructionFor[action.type] : BRIDGE_INSTRUCTION_COUNT;
+        request.weaponSlot = action.weaponSlot;
+        request.isHeadshot = action.isHeadshot;
+        memcpy(request.args, action.args, sizeof(request.args));
+        request.address = action.victimAddress;
+    }
+    MockChain::instance().submitBatch(requests, count, callback);
+}
+
+void NativeBridgePoll(void) {
+    if (!NativeBridgeEnabled()) return;
+
+    // Mock time starts at the first poll
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point start = Clock::now();
+    double now = std::chrono::duration<double>(Clock::now() - start).count();
+    MockChain::instance().poll(now);
+}
@@ -4,9 +4,10 @@
 #include <cmath>
 #include <cstdio>
 #include <iostream>
-#include "movement.h"
+#include "voice_manager.h"
+#include "action_queue.h"
 
-Player::Player() {
+Player::Player() : weapon(WEAPONS[LOADOUT[0]].magazine, WEAPONS[LOADOUT[1]].magazine) {
     camera.position = (Vector3){ 0.0f, 2.0f, 5.0f };
     camera.target = (Vector3){ 0.0f, 2.0f, 0.0f };
     camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
@@ -29,6 +30,7 @@ Player::Player() {
     isGrounded = false;
     isSprinting = false;
     isCrouching = false;
+    movementFlags = 0;
     
     // Health system
     health = 100.0f;
@@ -39,57 +41,27 @@ Player::Player() {
     // Gun state
     isShooting = false;
     shootCooldown = 0.0f;
-    ammo = 30;
-    maxAmmo = 30;
-    recoilOffset = 0.0f;
+    recoilShot = 0;
+    lastShotTime = 0.0;
+    selectWeapon(1);
     
     // Footstep audio
     currentFootstepIndex = 0;
-    currentInstanceIndex = 0;
     footstepTimer = 0.0f;
     footstepInterval = 0.4f; // Time between footsteps (will adjust based on speed)
     lastHorizontalSpeed = 0.0f;
     
-    // Load footstep sounds and pre-create all instances
-    #if defined(PLATFORM_WEB)
-        for (int i = 0; i < MAX_FOOTSTEP_SOUNDS; i++) {
-            char path[256];
-            snprintf(path, sizeof(path), "assets/character/audio/footsteps/Floor_step%d.wav", i);
-            if (FileExists(path)) {
-                footstepSounds[i] = LoadSound(path);
-                SetSoundVolume(footstepSounds[i], 0.3f); // Lower volume for footsteps
-                
-                // Pre-create instances for each sound
-                for (int j = 0; j < MAX_FOOTSTEP_INSTANCES; j++) {
-                    footstepInstances[i][j] = LoadSoundAlias(footstepSounds[i]);
-                }
-            }
-        }
-    #else
-        for (int i = 0; i < MAX_FOOTSTEP_SOUNDS; i++) {
-            char path[256];
-            snprintf(path, sizeof(path), "assets/character/audio/footsteps/Floor_step%d.wav", i);
-            footstepSounds[i] = LoadSound(path);
-            SetSoundVolume(footstepSounds[i], 0.3f);
-            
-            // Pre-create instances for each sound
-            for (int j = 0; j < MAX_FOOTSTEP_INSTANCES; j++) {
-                footstepInstances[i][j] = LoadSoundAlias(footstepSounds[i]);
-            }
-        }
-    #endif
+    // The first Player decodes the footsteps; the rest share them
+    for (int i = 0; i < MAX_FOOTSTEP_SOUNDS; i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "assets/character/audio/footsteps/Floor_step%d.wav", i);
+        footstepSounds[i] = SoundBank::instance().acquire(path, MAX_FOOTSTEP_INSTANCES);
+    }
 }
 
 Player::~Player() {
-    // Cleanup footstep sound instances
     for (int i = 0; i < MAX_FOOTSTEP_SOUNDS; i++) {
-        for (int j = 0; j < MAX_FOOTSTEP_INSTANCES; j++) {
-            UnloadSoundAlias(footstepInstances[i][j]);
-        }
-    }
-    // Cleanup footstep sounds
-    for (int i = 0; i < MAX_FOOTSTEP_SOUNDS; i++) {
-        UnloadSound(footstepSounds[i]);
+        SoundBank::instance().release(footstepSounds[i]);
     }
 }
 
@@ -178,14 +150,6 @@ void Player::handleInput(float deltaTime) {
         } else {
             forwardVelocity = 0.0f; // Strafing or moving backward
         }
-        // Submit onchain movement: encode flags from inputs
-        uint8_t flags = 0;
-        if (IsKeyDown(KEY_W)) flags |= 1 << 0;
-        if (IsKeyDown(KEY_S)) flags |= 1 << 1;
-        if (IsKeyDown(KEY_A)) flags |= 1 << 2;
-        if (IsKeyDown(KEY_D)) flags |= 1 << 3;
-        if (IsKeyDown(KEY_SPACE)) flags |= 1 << 4; // jump intent
-        if (isCrouching) flags |= 1 << 5;
     } else {
         // No horizontal movement
         velocity.x = 0.0f;
@@ -193,6 +157,15 @@ void Player::handleInput(float deltaTime) {
         forwardVelocity = 0.0f;
     }
     
+    // Input flags for movement sync
+    movementFlags = 0;
+    if (IsKeyDown(KEY_W)) movementFlags |= MOVE_FORWARD;
+    if (IsKeyDown(KEY_S)) movementFlags |= MOVE_BACK;
+    if (IsKeyDown(KEY_A)) movementFlags |= MOVE_LEFT;
+    if (IsKeyDown(KEY_D)) movementFlags |= MOVE_RIGHT;
+    if (IsKeyDown(KEY_SPACE)) movementFlags |= MOVE_JUMP; // Jump intent
+    if (isCrouching) movementFlags |= MOVE_CROUCH;
+    
     // Jump
     if (IsKeyPressed(KEY_SPACE) && isGrounded) {
         velocity.y = 8.0f;
@@ -208,6 +181,13 @@ void Player::handleInput(float deltaTime) {
     if (IsKeyPressed(KEY_R) && ammo < maxAmmo) {
         reload();
     }
+    
+    // Weapon slots: number keys, or the wheel (up for primary, down for
+    // secondary; more notches the same way keep the slot already selected)
+    if (IsKeyPressed(KEY_ONE)) switchWeapon(1);
+    if (IsKeyPressed(KEY_TWO)) switchWeapon(2);
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f) switchWeapon(wheel > 0.0f ? 1 : 2);
 }
 
 void Player::handleMobileInput(float deltaTime, Vector2 moveVector, bool sprint, bool jump, bool crouch, bool shoot, bool reload) {
@@ -267,6 +247,15 @@ void Player::handleMobileInput(float deltaTime, Vector2 moveVector, bool sprint,
         forwardVelocity = 0.0f;
     }
     
+    // Input flags for movement sync
+    movementFlags = 0;
+    if (moveVector.y < -0.3f) movementFlags |= MOVE_FORWARD;
+    if (moveVector.y > 0.3f) movementFlags |= MOVE_BACK;
+    if (moveVector.x < -0.3f) movementFlags |= MOVE_LEFT;
+    if (moveVector.x > 0.3f) movementFlags |= MOVE_RIGHT;
+    if (jump) movementFlags |= MOVE_JUMP;
+    if (isCrouching) movementFlags |= MOVE_CROUCH;
+    
     // Jump
     static bool lastJumpState = false;
     if (jump && !lastJumpState && isGrounded) {
@@ -326,15 +315,38 @@ void Player::applyGravity(float deltaTime) {
     }
 }
 
+// The shot itself (ammo, cooldown, recoil) is `fire`, once the caller has
+// the map and targets at hand
 void Player::shoot() {
     isShooting = true;
-    ammo--;
-    shootCooldown = 0.1f; // 600 RPM
-    recoilOffset = 0.5f;
 }
 
 void Player::reload() {
-    ammo = maxAmmo;
+    if (!weapon.reload(weaponSlot)) return;
+    ammo = weapon.ammo(weaponSlot);
+    shootCooldown = weaponDef->reloadTime;
+}
+
+void Player::selectWeapon(uint8_t slot) {
+    weaponSlot = slot;
+    weaponDef = &WEAPONS[LOADOUT[slot - 1]];
+    fire = fireFunction(LOADOUT[slot - 1]);
+    ammo = weapon.ammo(slot);
+    maxAmmo = weapon.magazine(slot);
+    recoilShot = 0;
+}
+
+void Player::switchWeapon(uint8_t slot) {
+    if (slot == weaponSlot || slot < 1 || slot > WeaponPrediction::SLOTS) return;
+    selectWeapon(slot);
+    ActionQueue::instance().enqueueSwitchWeapon(slot);
+}
+
+// Picks up confirmations, rollbacks and account updates; call after the
+// account mirror has dispatched
+void Player::updateWeapon(float deltaTime) {
+    weapon.update(deltaTime);
+    ammo = weapon.ammo(weaponSlot);
 }
 
 void Player::update(float deltaTime) {
@@ -343,12 +355,6 @@ void Player::update(float deltaTime) {
         shootCooldown -= deltaTime;
     }
     
-    // Recoil recovery
-    if (recoilOffset > 0.0f) {
-        recoilOffset -= deltaTime * 2.0f;
-        if (recoilOffset < 0.0f) recoilOffset = 0.0f;
-    }
-    
     handleMouseLook();
     handleInput(deltaTime);
     applyGravity(deltaTime);
@@ -368,11 +374,8 @@ void Player::playFootstep() {
     // Cycle through the 9 different footstep sounds
     currentFootstepIndex = (currentFootstepIndex + 1) % MAX_FOOTSTEP_SOUNDS;
     
-    // Play the pre-loaded sound instance (no loading/unloading needed!)
-    PlaySound(footstepInstances[currentFootstepIndex][currentInstanceIndex]);
-    
-    // Move to next instance for multi-channel support
-    currentInstanceIndex = (currentInstanceIndex + 1) % MAX_FOOTSTEP_INSTANCES;
+    // Any free instance of it; footsteps give way to gunshots when voices run out
+    VoiceManager::instance().play(footstepSounds[currentFootstepIndex], VOICE_PRIORITY_FOOTSTEP, FOOTSTEP_VOLUME);
 }
 
 void Player::updateFootsteps(float deltaTime) {
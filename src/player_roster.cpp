@@ -0,0 +1,119 @@
+#include "player_roster.h"
+#include <raymath.h>
+#include <cstring>
+
+static const float MAX_EXTRAPOLATION = 0.5f;   // Seconds
+static const float PLAYER_HEIGHT = 1.8f;        // Position accounts hold eye height, like the camera
+
+PlayerRoster::PlayerRoster() {
+    players = 0;
+    AccountMirror::instance().subscribe(ACCOUNT_UNKNOWN, onAccountChanged, this);
+}
+
+PlayerRoster::~PlayerRoster() {
+    AccountMirror::instance().unsubscribe(onAccountChanged, this);
+}
+
+RosterEntry* PlayerRoster::entryFor(const char* entity) {
+    if (!entity || !*entity) return nullptr;
+    for (int i = 0; i < players; i++) {
+        if (strcmp(entries[i].entity, entity) == 0) return &entries[i];
+    }
+    if (players == MAX_PLAYERS) return nullptr;
+
+    RosterEntry& entry = entries[players++];
+    memset(&entry, 0, sizeof(entry));
+    strncpy(entry.entity, entity, sizeof(entry.entity) - 1);
+    strncpy(entry.name, entity, sizeof(entry.name) - 1);
+    entry.local = AccountMirror::instance().isLocalEntity(entity);
+    entry.alive = true;
+    return &entry;
+}
+
+void PlayerRoster::onAccountChanged(const AccountRecord& record, void* user) {
+    PlayerRoster* roster = static_cast<PlayerRoster*>(user);
+    if (record.kind == ACCOUNT_GAME || record.kind == ACCOUNT_UNKNOWN) return;
+    RosterEntry* entry = roster->entryFor(record.entity);
+    if (!entry) return;
+
+    switch (record.kind) {
+        case ACCOUNT_POSITION: {
+            bolt::PositionView view;
+            if (!record.view(view)) return;
+            entry->position = (Vector3){ (float)view.x(), (float)view.y(), (float)view.z() };
+            entry->velocity = (Vector3){ view.velocityX(), view.velocityY(), view.velocityZ() };
+            entry->rotation = view.rotationY();
+            entry->sinceUpdate = 0.0f;
+            entry->hasPosition = true;
+            break;
+        }
+        case ACCOUNT_HEALTH: {
+            bolt::HealthView view;
+            if (!record.view(view)) return;
+            entry->health = view.currentHp();
+            entry->alive = view.isAlive();
+            break;
+        }
+        case ACCOUNT_PLAYER: {
+            bolt::PlayerView view;
+            if (!record.view(view)) return;
+            entry->team = view.team();
+            std::string_view username = view.username();
+            if (!username.empty()) {
+                size_t length = username.size() < sizeof(entry->name) - 1 ? username.size() : sizeof(entry->name) - 1;
+                memcpy(entry->name, username.data(), length);
+                entry->name[length] = '\0';
+            }
+            break;
+        }
+        case ACCOUNT_WEAPON: {
+            bolt::WeaponView view;
+            if (!record.view(view)) return;
+            // A reload refills the magazine; only drops are shots
+            uint32_t magazine[2] = { view.primaryAmmo(), view.secondaryAmmo() };
+            for (int slot = 0; slot < 2; slot++) {
+                if (entry->hasWeapon && magazine[slot] < entry->magazine[slot]) {
+                    entry->shotsFired[slot] += entry->magazine[slot] - magazine[slot];
+                }
+                entry->magazine[slot] = magazine[slot];
+            }
+            entry->hasWeapon = true;
+            break;
+        }
+        case ACCOUNT_PLAYER_STATS: {
+            bolt::PlayerStatsView view;
+            if (!record.view(view)) return;
+            entry->kills = view.kills();
+            entry->deaths = view.deaths();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void PlayerRoster::update(float deltaTime) {
+    for (int i = 0; i < players; i++) {
+        entries[i].sinceUpdate += deltaTime;
+    }
+}
+
+Vector3 PlayerRoster::predictedPosition(const RosterEntry& entry) const {
+    float elapsed = entry.sinceUpdate < MAX_EXTRAPOLATION ? entry.sinceUpdate : MAX_EXTRAPOLATION;
+    return Vector3Add(entry.position, Vector3Scale(entry.velocity, elapsed));
+}
+
+void PlayerRoster::draw() const {
+    for (int i = 0; i < players; i++) {
+        const RosterEntry& entry = entries[i];
+        if (entry.local || !entry.hasPosition || !entry.alive) continue;
+
+        Vector3 eye = predictedPosition(entry);
+        Vector3 feet = (Vector3){ eye.x, eye.y - PLAYER_HEIGHT, eye.z };
+        Color color = entry.team == 0 ? (Color){ 0, 200, 255, 255 } : (Color){ 255, 0, 150, 255 };
+
+        DrawCylinder(feet, 0.35f, 0.35f, PLAYER_HEIGHT - 0.3f, 8, Fade(color, 0.6f));
+        DrawCylinderWires(feet, 0.35f, 0.35f, PLAYER_HEIGHT - 0.3f, 8, color);
+        DrawSphere((Vector3){ eye.x, eye.y - 0.1f, eye.z }, 0.2f, color);
+    }
+}
@@ -0,0 +1,118 @@
+#include "positional_audio.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "voice_manager.h"
+
+static const int SOUND_INSTANCES = 4;           // Used only if this loads the sound first
+static const float MIN_STEP_SPEED = 1.0f;       // Slower than this is standing still, not walking
+static const float SPRINT_SPEED = 6.5f;
+
+PositionalAudio::PositionalAudio() {
+    tracked = 0;
+    nextFootstep = 0;
+    memset(&totals, 0, sizeof(totals));
+    for (int i = 0; i < FOOTSTEP_SOUNDS; i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "assets/character/audio/footsteps/Floor_step%d.wav", i);
+        footsteps[i] = SoundBank::instance().acquire(path, SOUND_INSTANCES);
+    }
+    for (int slot = 0; slot < SLOTS; slot++) {
+        const char* path = WEAPONS[LOADOUT[slot]].effect.sound;
+        ownsGunshot[slot] = slot == 0 || strcmp(path, WEAPONS[LOADOUT[0]].effect.sound) != 0;
+        gunshots[slot] = ownsGunshot[slot] ? SoundBank::instance().acquire(path, SOUND_INSTANCES) : gunshots[0];
+    }
+}
+
+PositionalAudio::~PositionalAudio() {
+    for (int i = 0; i < FOOTSTEP_SOUNDS; i++) {
+        SoundBank::instance().release(footsteps[i]);
+    }
+    for (int slot = 0; slot < SLOTS; slot++) {
+        if (ownsGunshot[slot]) SoundBank::instance().release(gunshots[slot]);
+    }
+}
+
+void PositionalAudio::update(const PlayerRoster& roster, Vector3 listener, Vector3 right, float deltaTime) {
+    int players = roster.count();
+
+    // New players start with what they have already fired, not a volley
+    for (; tracked < players; tracked++) {
+        stepTimer[tracked] = 0.0f;
+        for (int slot = 0; slot < SLOTS; slot++) {
+            shotsHeard[tracked][slot] = roster.entry(tracked).shotsFired[slot];
+        }
+    }
+
+    // Offsets from the listener; anyone not drawable is parked out of range
+    for (int i = 0; i < players; i++) {
+        const RosterEntry& entry = roster.entry(i);
+        if (entry.local || !entry.hasPosition || !entry.alive) {
+            offsetX[i] = offsetY[i] = offsetZ[i] = AUDIBLE_RADIUS * 2.0f;
+            continue;
+        }
+        Vector3 position = roster.predictedPosition(entry);
+        offsetX[i] = position.x - listener.x;
+        offsetY[i] = position.y - listener.y;
+        offsetZ[i] = position.z - listener.z;
+    }
+
+    // Gain and pan for everyone at once; out of range is gain 0
+    const float radiusSquared = AUDIBLE_RADIUS * AUDIBLE_RADIUS;
+    int audible = 0;
+    for (int i = 0; i < players; i++) {
+        float distanceSquared = offsetX[i] * offsetX[i] + offsetY[i] * offsetY[i] + offsetZ[i] * offsetZ[i];
+        if (distanceSquared >= radiusSquared) {
+            gain[i] = 0.0f;
+            pan[i] = 0.5f;
+            continue;
+        }
+        float distance = sqrtf(distanceSquared);
+        float falloff = distance > REFERENCE_DISTANCE ? REFERENCE_DISTANCE / distance : 1.0f;
+        gain[i] = falloff * (1.0f - distance / AUDIBLE_RADIUS);
+        // raylib pan runs from 0 (left) to 1 (right)
+        float side = distance > 0.001f ? (offsetX[i] * right.x + offsetY[i] * right.y + offsetZ[i] * right.z) / distance : 0.0f;
+        pan[i] = 0.5f + 0.5f * PAN_WIDTH * side;
+        audible++;
+    }
+    totals.audible = audible;
+
+    VoiceManager& voices = VoiceManager::instance();
+    for (int i = 0; i < players; i++) {
+        const RosterEntry& entry = roster.entry(i);
+        int shots[SLOTS];
+        for (int slot = 0; slot < SLOTS; slot++) {
+            shots[slot] = (int)(entry.shotsFired[slot] - shotsHeard[i][slot]);
+            shotsHeard[i][slot] = entry.shotsFired[slot];
+        }
+        if (entry.local) continue;
+        if (gain[i] <= 0.0f) {
+            totals.culled += shots[0] + shots[1];
+            stepTimer[i] = 0.0f;
+            continue;
+        }
+
+        // Each slot's own report, sharing the per-tick cap
+        int budget = MAX_SHOTS_PER_TICK;
+        for (int slot = 0; slot < SLOTS; slot++) {
+            float volume = WEAPONS[LOADOUT[slot]].effect.volume * gain[i];
+            for (int shot = 0; shot < shots[slot] && budget > 0; shot++, budget--) {
+                if (voices.play(gunshots[slot], VOICE_PRIORITY_GUNSHOT, volume, pan[i])) totals.played++;
+            }
+        }
+
+        // Same cadence as the local player's footsteps
+        float speed = sqrtf(entry.velocity.x * entry.velocity.x + entry.velocity.z * entry.velocity.z);
+        if (speed < MIN_STEP_SPEED) {
+            stepTimer[i] = 0.0f;
+            continue;
+        }
+        stepTimer[i] += deltaTime;
+        if (stepTimer[i] < (speed > SPRINT_SPEED ? 0.3f : 0.45f)) continue;
+        stepTimer[i] = 0.0f;
+        nextFootstep = (nextFootstep + 1) % FOOTSTEP_SOUNDS;
+        if (voices.play(footsteps[nextFootstep], VOICE_PRIORITY_FOOTSTEP, FOOTSTEP_VOLUME * gain[i], pan[i])) {
+            totals.played++;
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include "projectiles.h"
+#include <raymath.h>
+
+static const float STREAK_TIME = 0.02f;        // Drawn trail, as seconds of flight
+static const float PROJECTILE_SIZE = 0.08f;
+
+Projectiles::Projectiles() {
+    live = 0;
+    hits = 0;
+    stepTime = 0.0f;
+    stepGrid = nullptr;
+    stepTargets = nullptr;
+}
+
+bool Projectiles::spawn(Vector3 position, Vector3 velocity, float gravity, uint8_t weaponSlot) {
+    if (live >= MAX_PROJECTILES) return false;
+    int i = live++;
+    posX[i] = position.x;
+    posY[i] = position.y;
+    posZ[i] = position.z;
+    velX[i] = velocity.x;
+    velY[i] = velocity.y;
+    velZ[i] = velocity.z;
+    this->gravity[i] = gravity;
+    age[i] = 0.0f;
+    travelled[i] = 0.0f;
+    slot[i] = weaponSlot;
+    struck[i] = HIT_NONE;
+    struckPlayer[i] = -1;
+    return true;
+}
+
+void Projectiles::step(float deltaTime, const CollisionGrid& grid, const Hitboxes* targets) {
+    JobCounter done;
+    beginStep(deltaTime, grid, targets, done);
+    JobSystem::instance().wait(done);
+}
+
+void Projectiles::beginStep(float deltaTime, const CollisionGrid& grid, const Hitboxes* targets, JobCounter& done) {
+    JobSystem& jobs = JobSystem::instance();
+    stepTime = deltaTime;
+    stepGrid = &grid;
+    stepTargets = targets;
+    jobs.parallelFor(live, GRAIN, integrate, this, &integrated);
+    jobs.run(removeFinished, this, 0, 0, &done, &integrated);
+}
+
+void Projectiles::integrate(void* data, int begin, int end) {
+    Projectiles& p = *static_cast<Projectiles*>(data);
+    float deltaTime = p.stepTime;
+    const CollisionGrid& grid = *p.stepGrid;
+    const Hitboxes* targets = p.stepTargets;
+
+    for (int i = begin; i < end; i++) {
+        // Exact under constant gravity; the arc within one tick is swept as its chord
+        Vector3 from = { p.posX[i], p.posY[i], p.posZ[i] };
+        Vector3 to = {
+            from.x + p.velX[i] * deltaTime,
+            from.y + (p.velY[i] - 0.5f * p.gravity[i] * deltaTime) * deltaTime,
+            from.z + p.velZ[i] * deltaTime
+        };
+        p.velY[i] -= p.gravity[i] * deltaTime;
+        p.age[i] += deltaTime;
+
+        Vector3 delta = Vector3Subtract(to, from);
+        float length = Vector3Length(delta);
+        float fraction = 1.0f;
+        HitRegion region = HIT_NONE;
+        int player = -1;
+        if (grid.sweep(from, to, fraction)) region = HIT_WALL;
+
+        // Players in front of the map geometry
+        if (targets && length > 0.0f) {
+            ShotHit shot = targets->raycast((Ray){ from, Vector3Scale(delta, 1.0f / length) }, fraction * length, nullptr);
+            if (shot.player >= 0) {
+                region = shot.region;
+                player = shot.player;
+                fraction = shot.distance / length;
+            }
+        }
+
+        p.posX[i] = from.x + delta.x * fraction;
+        p.posY[i] = from.y + delta.y * fraction;
+        p.posZ[i] = from.z + delta.z * fraction;
+        p.travelled[i] += length * fraction;
+        p.struck[i] = region;
+        p.struckPlayer[i] = player;
+    }
+}
+
+void Projectiles::removeFinished(void* data, int begin, int end) {
+    (void)begin; (void)end; // One job over every projectile
+    Projectiles& p = *static_cast<Projectiles*>(data);
+    p.hits = 0;
+
+    // Swap-remove, recording what each one hit on the way out
+    for (int i = 0; i < p.live;) {
+        if (p.struck[i] == HIT_NONE && p.age[i] < MAX_LIFETIME) {
+            ++i;
+            continue;
+        }
+        if (p.struck[i] != HIT_NONE) {
+            ProjectileHit& hit = p.hitList[p.hits++];
+            hit.region = p.struck[i];
+            hit.player = p.struckPlayer[i];
+            hit.weaponSlot = p.slot[i];
+            hit.distance = p.travelled[i];
+            hit.point = (Vector3){ p.posX[i], p.posY[i], p.posZ[i] };
+        }
+        int last = --p.live;
+        p.posX[i] = p.posX[last];
+        p.posY[i] = p.posY[last];
+        p.posZ[i] = p.posZ[last];
+        p.velX[i] = p.velX[last];
+        p.velY[i] = p.velY[last];
+        p.velZ[i] = p.velZ[last];
+        p.gravity[i] = p.gravity[last];
+        p.age[i] = p.age[last];
+        p.travelled[i] = p.travelled[last];
+        p.slot[i] = p.slot[last];
+        p.struck[i] = p.struck[last];
+        p.struckPlayer[i] = p.struckPlayer[last];
+    }
+}
+
+void Projectiles::draw() const {
+    for (int i = 0; i < live; i++) {
+        Vector3 position = { posX[i], posY[i], posZ[i] };
+        Vector3 tail = { posX[i] - velX[i] * STREAK_TIME, posY[i] - velY[i] * STREAK_TIME, posZ[i] - velZ[i] * STREAK_TIME };
+        DrawCube(position, PROJECTILE_SIZE, PROJECTILE_SIZE, PROJECTILE_SIZE, (Color){ 255, 150, 0, 255 });
+        DrawLine3D(tail, position, (Color){ 255, 220, 120, 200 });
+    }
+}
+
+void Projectiles::clear() {
+    live = 0;
+    hits = 0;
+}
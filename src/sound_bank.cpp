@@ -0,0 +1,151 @@
+#include "sound_bank.h"
+#include <cstring>
+#include "asset_loader.h"
+#include "voice_manager.h"
+
+SoundBank& SoundBank::instance() {
+    static SoundBank bank;
+    return bank;
+}
+
+SoundBank::SoundBank() {
+    memset(entries, 0, sizeof(entries));
+    memset(&totals, 0, sizeof(totals));
+}
+
+SoundId SoundBank::acquire(const char* path, int instances, bool critical) {
+    int freeEntry = -1;
+    for (int i = 0; i < MAX_SOUNDS; i++) {
+        Entry& entry = entries[i];
+        if (entry.state == ENTRY_FREE) {
+            if (freeEntry < 0) freeEntry = i;
+            continue;
+        }
+        // Includes a sound whose last holder let go while it was decoding
+        if (strncmp(entry.path, path, PATH_SIZE) == 0) {
+            entry.references++;
+            totals.references++;
+            return (SoundId)(i + 1);
+        }
+    }
+
+    if (freeEntry < 0) {
+        TraceLog(LOG_WARNING, "SOUND BANK: Full, not loading %s", path);
+        return 0;
+    }
+    const AssetPackEntry* packed = AssetPack::instance().find(path);
+    if (strlen(path) >= (size_t)PATH_SIZE || (!packed && !FileExists(path))) {
+        TraceLog(LOG_WARNING, "SOUND BANK: Could not load %s", path);
+        return 0;
+    }
+
+    Entry& entry = entries[freeEntry];
+    memset(&entry, 0, sizeof(entry));
+    strncpy(entry.path, path, PATH_SIZE - 1);
+    if (instances < 1) instances = 1;
+    if (instances > MAX_INSTANCES) instances = MAX_INSTANCES;
+    entry.packed = packed;
+    entry.critical = critical;
+    entry.aliasCount = instances;
+    entry.references = 1;
+    totals.loading++;
+    totals.references++;
+    if (packed && !AssetPack::instance().resident(packed)) {
+        entry.state = ENTRY_WAITING;
+    } else {
+        startDecode(entry);
+    }
+    return (SoundId)(freeEntry + 1);
+}
+
+void SoundBank::startDecode(Entry& entry) {
+    entry.state = ENTRY_DECODING;
+    AssetLoader::instance().submit(GetFileName(entry.path), entry.critical, decode, decoded, &entry);
+}
+
+// Only the file read and decode; turning samples into a sound needs the
+// audio device, which belongs to the main thread
+void SoundBank::decode(void* user) {
+    Entry& entry = *static_cast<Entry*>(user);
+    entry.wave = entry.packed ? AssetPack::instance().loadWave(entry.packed) : LoadWave(entry.path);
+}
+
+void SoundBank::decoded(void* user) {
+    Entry& entry = *static_cast<Entry*>(user);
+    SoundBank& bank = instance();
+    bank.totals.decodes++;
+    if (IsWaveValid(entry.wave)) {
+        entry.state = ENTRY_DECODED;
+        return;
+    }
+    TraceLog(LOG_WARNING, "SOUND BANK: Could not decode %s", entry.path);
+    entry.state = ENTRY_FAILED;
+    bank.totals.loading--;
+    if (entry.references == 0) entry.state = ENTRY_FREE;
+}
+
+void SoundBank::update() {
+    AssetPack& pack = AssetPack::instance();
+    for (int i = 0; i < MAX_SOUNDS; i++) {
+        Entry& entry = entries[i];
+        if (entry.state == ENTRY_WAITING) {
+            AssetPack::PackState state = pack.state(entry.packed);
+            if (entry.references == 0 || state == AssetPack::PACK_FAILED) {
+                if (entry.references > 0) TraceLog(LOG_WARNING, "SOUND BANK: %s never arrived", entry.path);
+                totals.loading--;
+                entry.state = entry.references > 0 ? ENTRY_FAILED : ENTRY_FREE;
+            } else if (state == AssetPack::PACK_RESIDENT) {
+                startDecode(entry);
+            }
+            continue;
+        }
+        if (entry.state != ENTRY_DECODED) continue;
+        totals.loading--;
+        if (entry.references == 0) {
+            UnloadWave(entry.wave);
+            entry.state = ENTRY_FREE;
+            continue;
+        }
+        entry.sound = LoadSoundFromWave(entry.wave);
+        UnloadWave(entry.wave);
+        for (int j = 0; j < entry.aliasCount; j++) {
+            entry.aliases[j] = LoadSoundAlias(entry.sound);
+        }
+        entry.state = ENTRY_READY;
+        totals.loaded++;
+    }
+}
+
+void SoundBank::unload(Entry& entry) {
+    VoiceManager::instance().release(entry.aliases, entry.aliasCount);
+    for (int i = 0; i < entry.aliasCount; i++) {
+        UnloadSoundAlias(entry.aliases[i]);
+    }
+    UnloadSound(entry.sound);
+    totals.loaded--;
+}
+
+void SoundBank::release(SoundId id) {
+    if (id == 0 || id > MAX_SOUNDS) return;
+    Entry& entry = entries[id - 1];
+    if (entry.references == 0) return;
+    totals.references--;
+    if (--entry.references > 0) return;
+
+    // Still loading: decoded() or update() frees it once the loader is done with it
+    if (entry.state == ENTRY_WAITING || entry.state == ENTRY_DECODING || entry.state == ENTRY_DECODED) return;
+    if (entry.state == ENTRY_READY) unload(entry);
+    entry.state = ENTRY_FREE;
+}
+
+const Sound* SoundBank::instances(SoundId id, int& count) const {
+    count = 0;
+    if (!ready(id)) return nullptr;
+    const Entry& entry = entries[id - 1];
+    count = entry.aliasCount;
+    return entry.aliases;
+}
+
+bool SoundBank::ready(SoundId id) const {
+    return id != 0 && id <= MAX_SOUNDS && entries[id - 1].state == ENTRY_READY;
+}
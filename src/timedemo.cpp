@@ -0,0 +1,253 @@
+#include "timedemo.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "game.h"
+#include "job_system.h"
+#include "sound_bank.h"
+#include "asset_loader.h"
+#include "alloc_tracker.h"
+#include "frame_arena.h"
+#include "action_queue.h"
+#include "account_mirror.h"
+
+#if !defined(PLATFORM_WEB)
+    #include "native_bridge.h"
+    #include "mock_chain.h"
+#endif
+
+// Recorded walk through the arena: in from the south-west base, a lap around
+// the center platform, then up the east side looking at the sky logo.
+static const TimedemoKeyframe demoPath[] = {
+    {  0.0f, { -30.0f, 1.8f,  42.0f }, -1.20f, 0.00f },
+    {  3.0f, { -10.0f, 1.8f,  30.0f }, -1.40f, 0.05f },
+    {  6.0f, { -12.0f, 1.8f,  12.0f }, -0.80f, 0.10f },
+    {  9.0f, { -12.0f, 1.8f, -12.0f },  0.79f, 0.10f },
+    { 12.0f, {  12.0f, 1.8f, -12.0f },  2.36f, 0.10f },
+    { 15.0f, {  12.0f, 1.8f,  12.0f },  3.93f, 0.10f },
+    { 18.0f, {  30.0f, 1.8f,  30.0f },  4.40f, 0.00f },
+    { 21.0f, {  35.0f, 1.8f,  10.0f },  4.40f, 0.90f },
+    { 24.0f, {  40.0f, 1.8f, -30.0f },  4.70f, 0.00f },
+};
+static const int demoKeyframeCount = sizeof(demoPath) / sizeof(demoPath[0]);
+
+// Trigger held during these windows (600 RPM, so tracers and impact sparks pile up)
+static const TimedemoBurst demoBursts[] = {
+    {  2.0f,  3.0f },
+    {  7.0f,  8.5f },
+    { 10.5f, 11.0f },
+    { 13.0f, 14.5f },
+    { 19.0f, 20.0f },
+    { 22.0f, 23.5f },
+};
+static const int demoBurstCount = sizeof(demoBursts) / sizeof(demoBursts[0]);
+
+static TimedemoKeyframe samplePath(float time) {
+    if (time <= demoPath[0].time) return demoPath[0];
+    for (int i = 1; i < demoKeyframeCount; i++) {
+        const TimedemoKeyframe& a = demoPath[i - 1];
+        const TimedemoKeyframe& b = demoPath[i];
+        if (time <= b.time) {
+            float t = (time - a.time) / (b.time - a.time);
+            t = t * t * (3.0f - 2.0f * t); // Ease between keyframes
+            TimedemoKeyframe k;
+            k.time = time;
+            k.position = Vector3Lerp(a.position, b.position, t);
+            k.yaw = Lerp(a.yaw, b.yaw, t);
+            k.pitch = Lerp(a.pitch, b.pitch, t);
+            return k;
+        }
+    }
+    return demoPath[demoKeyframeCount - 1];
+}
+
+static bool triggerHeld(float time) {
+    for (int i = 0; i < demoBurstCount; i++) {
+        if (time >= demoBursts[i].start && time < demoBursts[i].end) return true;
+    }
+    return false;
+}
+
+// Percentile of an ascending-sorted sample (nearest rank)
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = (size_t)ceil(p * sorted.size());
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+bool Timedemo::requested(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--timedemo") == 0) return true;
+    }
+    return false;
+}
+
+int Timedemo::run(int argc, char** argv) {
+    const char* csvPath = nullptr;
+    for (int i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "--timedemo-csv") == 0) csvPath = argv[i + 1];
+    }
+
+    // Hidden window, no vsync: the offscreen target is what gets measured
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(RENDER_WIDTH, RENDER_HEIGHT, "solfps.xyz - timedemo");
+    if (!IsWindowReady()) {
+        fprintf(stderr, "timedemo: could not create a GL context\n");
+        return 1;
+    }
+    SetTargetFPS(0);
+    InitAudioDevice();
+    JobSystem::instance().start();
+    SetRandomSeed(1337);
+
+    RenderTexture2D target = LoadRenderTexture(RENDER_WIDTH, RENDER_HEIGHT);
+
+    // The bridge path SOLFPS_MOCK_CHAIN=1 plays against, stepped on the demo's clock
+    #if !defined(PLATFORM_WEB)
+        NativeBridgeSetEnabled(true);
+    #endif
+
+    int exitCode = 0;
+    {
+        // The game's own state and frame code; too big for the stack
+        static Game game;
+        Player& player = game.player;
+        Gun& gun = game.gun;
+        game.phase = PHASE_PLAYING;
+        game.audioReady = true;
+        game.map.loadCyberpunkArena();
+        game.mapGrid.build(game.map);
+        // Everything loaded before the clock starts, decoding inline
+        AssetLoader::instance().finish();
+        SoundBank::instance().update();
+        #if !defined(PLATFORM_WEB)
+            ActionQueue::instance().setEnabled(true);
+            AccountMirror::instance().connectFeed();
+        #endif
+
+        const float dt = 1.0f / 60.0f;
+        const float duration = demoPath[demoKeyframeCount - 1].time;
+        const int frameCount = (int)(duration / dt);
+        std::vector<double> frameTimes;
+        frameTimes.reserve(frameCount);
+        int allocatingFrames = 0;
+        bool countAllocations = AllocTracker::enabled();
+        if (!countAllocations) {
+            printf("timedemo: allocations not counted; configure with -DALLOC_TRACKING=ON to check them\n");
+        }
+
+        for (int frame = 0; frame < frameCount; frame++) {
+            double frameStart = GetTime();
+            float time = frame * dt;
+            AllocTracker::beginFrame();
+            AllocTracker::setSubsystem(ALLOC_PLAYER);
+
+            // Drive the camera along the path
+            TimedemoKeyframe k = samplePath(time);
+            player.yaw = k.yaw;
+            player.pitch = k.pitch;
+            player.camera.position = k.position;
+            player.camera.target = Vector3Add(player.camera.position, player.getForward());
+
+            // Scripted shooting
+            AllocTracker::setSubsystem(ALLOC_EFFECTS);
+            if (player.shootCooldown > 0.0f) {
+                player.shootCooldown -= dt;
+            }
+            if (triggerHeld(time) && player.shootCooldown <= 0.0f) {
+                if (player.ammo <= 0) {
+                    player.reload(); // Holds fire for the weapon's reload time
+                } else {
+                    player.shoot();
+                }
+            }
+            gun.update(dt, true, player.isShooting, false, false);
+
+            // Confirmations and the bots' feed land on the same frames every run
+            AllocTracker::setSubsystem(ALLOC_BRIDGE);
+            #if !defined(PLATFORM_WEB)
+                MockChain::instance().poll(time);
+            #endif
+
+            // The game's frame from here on: fire, projectiles, particles, bridge, roster
+            game.step(dt);
+
+            // Same drawing as the game frame, into the fixed-size target
+            BeginTextureMode(target);
+                ClearBackground((Color){ 5, 5, 10, 255 });
+                game.drawScene();
+                game.drawHUD(RENDER_WIDTH, RENDER_HEIGHT);
+            EndTextureMode();
+
+            AllocTracker::setSubsystem(ALLOC_RENDER);
+            BeginDrawing();
+                DrawTextureRec(target.texture, (Rectangle){ 0, 0, (float)RENDER_WIDTH, -(float)RENDER_HEIGHT },
+                               (Vector2){ 0, 0 }, WHITE);
+            EndDrawing();
+            FrameArena::frame().reset();
+            AllocTracker::setSubsystem(ALLOC_OTHER);
+
+            if (frame >= WARMUP_FRAMES) {
+                frameTimes.push_back((GetTime() - frameStart) * 1000.0);
+                
+                // Steady-state frames must not touch the heap
+                if (countAllocations && AllocTracker::frameAllocations() > 0) {
+                    if (allocatingFrames == 0) {
+                        printf("timedemo: frame %d allocated\n", frame);
+                        AllocTracker::printFrameReport("timedemo");
+                    }
+                    allocatingFrames++;
+                }
+            }
+        }
+
+        if (csvPath) {
+            FILE* csv = fopen(csvPath, "w");
+            if (csv) {
+                fprintf(csv, "frame,ms\n");
+                for (size_t i = 0; i < frameTimes.size(); i++) {
+                    fprintf(csv, "%zu,%.4f\n", i + WARMUP_FRAMES, frameTimes[i]);
+                }
+                fclose(csv);
+            } else {
+                fprintf(stderr, "timedemo: could not write %s\n", csvPath);
+                exitCode = 1;
+            }
+        }
+
+        std::vector<double> sorted = frameTimes;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (double ms : frameTimes) total += ms;
+        double average = sorted.empty() ? 0.0 : total / sorted.size();
+
+        printf("timedemo: %zu frames at %dx%d (%d warmup frames skipped)\n",
+               sorted.size(), RENDER_WIDTH, RENDER_HEIGHT, WARMUP_FRAMES);
+        printf("timedemo: avg %.3f ms  p50 %.3f ms  p95 %.3f ms  p99 %.3f ms  max %.3f ms  (%.1f fps)\n",
+               average, percentile(sorted, 0.50), percentile(sorted, 0.95), percentile(sorted, 0.99),
+               sorted.empty() ? 0.0 : sorted.back(), average > 0.0 ? 1000.0 / average : 0.0);
+        
+        if (allocatingFrames > 0) {
+            printf("timedemo: FAILED, %d steady-state frame(s) allocated\n", allocatingFrames);
+            exitCode = 1;
+        } else if (countAllocations) {
+            printf("timedemo: zero heap allocations in steady state\n");
+        }
+    }
+
+    UnloadRenderTexture(target);
+    #if !defined(PLATFORM_WEB)
+        ActionQueue::instance().setEnabled(false);
+    #endif
+    JobSystem::instance().stop();
+    CloseAudioDevice();
+    CloseWindow();
+
+    return exitCode;
+}
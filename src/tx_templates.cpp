@@ -0,0 +1,605 @@
+#include "tx_templates.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "bolt_components.h"
+#include "account_mirror.h"
+
+#if defined(PLATFORM_WEB) && defined(SOLFPS_TX_TEMPLATES)
+    #include <emscripten/emscripten.h>
+#endif
+
+static const char* COMPUTE_BUDGET_PROGRAM = "ComputeBudget111111111111111111111111111111";
+static const uint8_t SET_COMPUTE_UNIT_LIMIT = 2;
+static const uint8_t SET_COMPUTE_UNIT_PRICE = 3;
+
+// Bolt's World program and its apply instruction (sha256("global:apply")),
+// which runs a system and writes back the components it returns
+static const char* WORLD_PROGRAM = "WorLD15A7CrDwLcLy4fRqtaTb9fbd8o8iqiEMUDse2n";
+static const uint8_t APPLY_DISCRIMINATOR[bolt::DISCRIMINATOR_SIZE] = { 248, 243, 145, 24, 105, 50, 162, 225 };
+
+// What each BatchActionType becomes on chain
+struct SystemInstruction {
+    const char* program;
+    const bolt::accounts::Meta* accounts;
+    int accountCount;
+    uint32_t writes;        // TxAccount bits of the components the system changes
+};
+
+#define SYSTEM(NAME, WRITES) \
+    { bolt::program::NAME, bolt::accounts::NAME, \
+      (int)(sizeof(bolt::accounts::NAME) / sizeof(bolt::accounts::NAME[0])), WRITES }
+#define WRITES(account) (1u << (account))
+
+// Writes as the mock chain's versions of the systems make them
+static const SystemInstruction SYSTEMS[BATCH_ACTION_APPLY_DAMAGE + 1] = {
+    SYSTEM(MOVEMENT, WRITES(TX_ACCOUNT_POSITION)),          // BATCH_ACTION_MOVEMENT
+    SYSTEM(SHOOT, WRITES(TX_ACCOUNT_WEAPON)),               // BATCH_ACTION_SHOOT
+    SYSTEM(RELOAD, WRITES(TX_ACCOUNT_WEAPON)),              // BATCH_ACTION_RELOAD
+    SYSTEM(SWITCH_WEAPON, WRITES(TX_ACCOUNT_WEAPON)),       // BATCH_ACTION_SWITCH_WEAPON
+    SYSTEM(APPLY_DAMAGE, WRITES(TX_ACCOUNT_PLAYER_STATS) | WRITES(TX_ACCOUNT_GAME) | WRITES(TX_ACCOUNT_VICTIM) |
+                         WRITES(TX_ACCOUNT_VICTIM_HEALTH) | WRITES(TX_ACCOUNT_VICTIM_STATS))    // BATCH_ACTION_APPLY_DAMAGE
+};
+
+#undef WRITES
+#undef SYSTEM
+
+// Component program each account belongs to; null for the ones that aren't components
+static const char* const COMPONENT_PROGRAMS[TX_ACCOUNT_COUNT] = {
+    nullptr,                        // TX_ACCOUNT_AUTHORITY
+    bolt::program::PLAYER,
+    bolt::program::WEAPON,
+    bolt::program::POSITION,
+    bolt::program::HEALTH,
+    bolt::program::PLAYERSTATS,
+    bolt::program::GAME,
+    nullptr,                        // TX_ACCOUNT_WORLD
+    bolt::program::PLAYER,          // TX_ACCOUNT_VICTIM
+    bolt::program::HEALTH,
+    bolt::program::PLAYERSTATS
+};
+
+// IDL component names, as they appear across the system IDLs
+static bool accountForName(const char* name, TxAccount* account) {
+    static const struct { const char* name; TxAccount account; } names[] = {
+        { "player", TX_ACCOUNT_PLAYER }, { "attacker", TX_ACCOUNT_PLAYER },
+        { "weapon", TX_ACCOUNT_WEAPON }, { "attacker_weapon", TX_ACCOUNT_WEAPON },
+        { "position", TX_ACCOUNT_POSITION },
+        { "health", TX_ACCOUNT_HEALTH },
+        { "player_stats", TX_ACCOUNT_PLAYER_STATS }, { "attacker_stats", TX_ACCOUNT_PLAYER_STATS },
+        { "game", TX_ACCOUNT_GAME },
+        { "victim", TX_ACCOUNT_VICTIM },
+        { "victim_health", TX_ACCOUNT_VICTIM_HEALTH },
+        { "victim_stats", TX_ACCOUNT_VICTIM_STATS }
+    };
+    for (const auto& entry : names) {
+        if (strcmp(entry.name, name) == 0) {
+            *account = entry.account;
+            return true;
+        }
+    }
+    return false;
+}
+
+static double secondsNow() {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+bool TxTemplates::decodeBase58(const char* text, uint8_t* out, int size) {
+    static const char* ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    if (!text) return false;
+
+    // Big-endian base-256 accumulator, least significant byte at out[size - 1]
+    memset(out, 0, size);
+    int leadingZeros = 0;
+    bool leading = true;
+    for (const char* c = text; *c; c++) {
+        const char* digit = strchr(ALPHABET, *c);
+        if (!digit) return false;
+        if (leading && *c == '1') {
+            leadingZeros++;
+            continue;
+        }
+        leading = false;
+
+        uint32_t carry = (uint32_t)(digit - ALPHABET);
+        for (int i = size - 1; i >= 0; i--) {
+            carry += (uint32_t)out[i] * 58;
+            out[i] = (uint8_t)carry;
+            carry >>= 8;
+        }
+        if (carry) return false; // More than `size` bytes
+    }
+
+    // The significant bytes plus one zero byte per leading '1' must fill `size` exactly
+    int significant = size;
+    for (int i = 0; i < size && out[i] == 0; i++) significant--;
+    return significant + leadingZeros == size;
+}
+
+TxTemplates& TxTemplates::instance() {
+    static TxTemplates templates;
+    return templates;
+}
+
+TxTemplates::TxTemplates() {
+    unitsPerInstruction = DEFAULT_UNIT_LIMIT;
+    unitPrice = 0;
+    decodeBase58(COMPUTE_BUDGET_PROGRAM, computeBudgetKey, KEY_SIZE);
+    decodeBase58(WORLD_PROGRAM, worldProgramKey, KEY_SIZE);
+    memset(componentProgramKeys, 0, sizeof(componentProgramKeys));
+    for (int account = 0; account < TX_ACCOUNT_COUNT; account++) {
+        if (COMPONENT_PROGRAMS[account]) decodeBase58(COMPONENT_PROGRAMS[account], componentProgramKeys[account], KEY_SIZE);
+    }
+    for (int type = 0; type <= BATCH_ACTION_APPLY_DAMAGE; type++) {
+        const SystemInstruction& system = SYSTEMS[type];
+        decodeBase58(system.program, systemKeys[type], KEY_SIZE);
+        componentCount[type] = 0;
+        for (int i = 0; i < system.accountCount; i++) {
+            if (system.accounts[i].signer) continue; // The authority; apply passes it on
+            TxAccount account;
+            if (!accountForName(system.accounts[i].name, &account) || componentCount[type] == MAX_COMPONENTS) {
+                account = TX_ACCOUNT_COUNT; // Unknown or too many; prepare() will refuse
+                componentCount[type] = 0;
+            }
+            components[type][componentCount[type]++] = account;
+            if (account == TX_ACCOUNT_COUNT) break;
+        }
+    }
+    reset();
+}
+
+void TxTemplates::reset() {
+    memset(known, 0, sizeof(known));
+    memset(victims, 0, sizeof(victims));
+    victimClock = 0;
+    hasBlockhash = false;
+    blockhashTime = 0.0;
+    prepared = false;
+#if defined(PLATFORM_WEB) && defined(SOLFPS_TX_TEMPLATES)
+    EM_ASM({
+        if (Module.txTemplatesBlockhashTimer) {
+            clearInterval(Module.txTemplatesBlockhashTimer);
+            Module.txTemplatesBlockhashTimer = null;
+        }
+    });
+#endif
+}
+
+bool TxTemplates::setAccount(TxAccount account, const char* base58) {
+    uint8_t key[KEY_SIZE];
+    if (account >= TX_ACCOUNT_VICTIM || !decodeBase58(base58, key, KEY_SIZE)) return false;
+    setAccountKey(account, key);
+    return true;
+}
+
+void TxTemplates::setAccountKey(TxAccount account, const uint8_t* key) {
+    if (account >= TX_ACCOUNT_VICTIM) return;
+    memcpy(sessionKeys[account], key, KEY_SIZE);
+    known[account] = true;
+    prepared = false;
+}
+
+void TxTemplates::setComputeBudget(uint32_t unitsPerInstruction, uint64_t microLamportsPerUnit) {
+    this->unitsPerInstruction = unitsPerInstruction;
+    unitPrice = microLamportsPerUnit;
+    prepared = false;
+}
+
+bool TxTemplates::setBlockhash(const char* base58) {
+    uint8_t hash[KEY_SIZE];
+    if (!decodeBase58(base58, hash, KEY_SIZE)) return false;
+    setBlockhashKey(hash);
+    return true;
+}
+
+void TxTemplates::setBlockhashKey(const uint8_t* hash) {
+    memcpy(blockhash, hash, KEY_SIZE);
+    hasBlockhash = true;
+    blockhashTime = secondsNow();
+}
+
+bool TxTemplates::ready() const {
+    return prepared && hasBlockhash && secondsNow() - blockhashTime < BLOCKHASH_LIFETIME;
+}
+
+bool TxTemplates::prepare() {
+    prepared = false;
+    for (int account = 0; account < TX_ACCOUNT_VICTIM; account++) {
+        if (!known[account]) return false;
+    }
+
+    for (int type = 0; type <= BATCH_ACTION_APPLY_DAMAGE; type++) {
+        for (int i = 0; i < componentCount[type]; i++) {
+            if (components[type][i] == TX_ACCOUNT_COUNT) return false;
+        }
+        BatchAction action;
+        memset(&action, 0, sizeof(action));
+        action.type = (uint8_t)type;
+        Template& layout = templates[type];
+        layout.size = compile(&action, 1, layout.message, &layout);
+        if (layout.size == 0) return false;
+    }
+    prepared = true;
+    return true;
+}
+
+static int writeCompactU16(uint8_t* out, uint32_t value) {
+    int length = 0;
+    while (true) {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value == 0) {
+            out[length++] = byte;
+            return length;
+        }
+        out[length++] = byte | 0x80;
+    }
+}
+
+// A number as JSON.stringify writes the f32 the bridge reads off the heap:
+// the fewest digits that read back as the same value
+static int writeNumber(char* out, int size, float value) {
+    if (!std::isfinite(value)) return snprintf(out, size, "null");
+    double exact = value;
+    int length = 0;
+    for (int precision = 1; precision <= 17; precision++) {
+        length = snprintf(out, size, "%.*g", precision, exact);
+        if (length >= size || strtod(out, nullptr) == exact) break;
+    }
+    return length;
+}
+
+// The system's arguments as the bridge's ApplySystem calls send them: the
+// JSON text of an object holding the bridge call's arguments. Returns 0 if
+// it doesn't fit in MAX_ARGS_SIZE.
+static int writeArgs(const BatchAction& action, char* out) {
+    static const char* const MOVEMENT_FIELDS[7] = {
+        "x", "y", "z", "rotation", "velocity_x", "velocity_y", "velocity_z"
+    };
+    const int size = TxTemplates::MAX_ARGS_SIZE;
+    int length = 0;
+    switch (action.type) {
+        case BATCH_ACTION_MOVEMENT:
+            for (int i = 0; i < 7 && length < size; i++) {
+                length += snprintf(out + length, size - length, "%c\"%s\":", i == 0 ? '{' : ',', MOVEMENT_FIELDS[i]);
+                if (length < size) length += writeNumber(out + length, size - length, action.args[i]);
+            }
+            break;
+        case BATCH_ACTION_SHOOT:
+        case BATCH_ACTION_RELOAD:
+        case BATCH_ACTION_SWITCH_WEAPON:
+            length = snprintf(out, size, "{\"weapon_slot\":%u", (unsigned)action.weaponSlot);
+            break;
+        case BATCH_ACTION_APPLY_DAMAGE:
+            length = snprintf(out, size, "{\"weapon_type\":%u,\"is_headshot\":%u,\"distance\":",
+                              (unsigned)action.weaponSlot, action.isHeadshot ? 1u : 0u);
+            if (length < size) length += writeNumber(out + length, size - length, action.args[0]);
+            break;
+        default:
+            return 0;
+    }
+    if (length < size) length += snprintf(out + length, size - length, "}");
+    return length < size ? length : 0;
+}
+
+// Placeholder victim keys for the apply damage template; patched per call
+static const uint8_t* placeholderVictim() {
+    static uint8_t keys[3 * TxTemplates::KEY_SIZE];
+    static bool filled = false;
+    if (!filled) {
+        for (int i = 0; i < 3; i++) memset(keys + i * TxTemplates::KEY_SIZE, 0xF0 + i, TxTemplates::KEY_SIZE);
+        filled = true;
+    }
+    return keys;
+}
+
+// Lays out a legacy message: header, account keys (signers first, then
+// writable before read-only), recent blockhash, compute budget, then one
+// World apply per action. Returns 0 if it doesn't fit or a victim is missing.
+uint32_t TxTemplates::compile(const BatchAction* actions, int count, uint8_t* out, Template* layout) {
+    if (count < 1 || count > MAX_INSTRUCTIONS) return 0;
+
+    struct Key {
+        const uint8_t* bytes;
+        bool signer;
+        bool writable;
+    };
+    Key keys[MAX_KEYS];
+    int keyCount = 0;
+    auto addKey = [&](const uint8_t* bytes, bool signer, bool writable) -> int {
+        for (int i = 0; i < keyCount; i++) {
+            if (memcmp(keys[i].bytes, bytes, KEY_SIZE) == 0) {
+                keys[i].signer |= signer;
+                keys[i].writable |= writable;
+                return i;
+            }
+        }
+        if (keyCount == MAX_KEYS) return -1;
+        keys[keyCount] = (Key){ bytes, signer, writable };
+        return keyCount++;
+    };
+
+    // Account keys of every instruction, as indexes into keys[]
+    int systemIndex[MAX_INSTRUCTIONS];
+    int programIndex[MAX_INSTRUCTIONS][MAX_COMPONENTS];
+    int componentIndex[MAX_INSTRUCTIONS][MAX_COMPONENTS];
+    int argSize[MAX_INSTRUCTIONS];
+    char args[MAX_ARGS_SIZE];
+    int authorityIndex = addKey(sessionKeys[TX_ACCOUNT_AUTHORITY], true, true); // Fee payer comes first
+    int budgetIndex = addKey(computeBudgetKey, false, false);
+    int worldProgramIndex = addKey(worldProgramKey, false, false);
+    int worldIndex = addKey(sessionKeys[TX_ACCOUNT_WORLD], false, false);
+    for (int i = 0; i < count; i++) {
+        const BatchAction& action = actions[i];
+        if (action.type > BATCH_ACTION_APPLY_DAMAGE) return 0;
+        const SystemInstruction& system = SYSTEMS[action.type];
+
+        const uint8_t* victim = nullptr;
+        if (action.type == BATCH_ACTION_APPLY_DAMAGE) {
+            victim = layout ? placeholderVictim() : victimKeys(action.victimAddress);
+            if (!victim) return 0;
+        }
+
+        systemIndex[i] = addKey(systemKeys[action.type], false, false);
+        if (systemIndex[i] < 0) return 0;
+        for (int c = 0; c < componentCount[action.type]; c++) {
+            TxAccount account = components[action.type][c];
+            const uint8_t* bytes = account >= TX_ACCOUNT_VICTIM
+                ? victim + (account - TX_ACCOUNT_VICTIM) * KEY_SIZE
+                : sessionKeys[account];
+            programIndex[i][c] = addKey(componentProgramKeys[account], false, false);
+            componentIndex[i][c] = addKey(bytes, false, (system.writes >> account) & 1);
+            if (programIndex[i][c] < 0 || componentIndex[i][c] < 0) return 0;
+        }
+        argSize[i] = writeArgs(action, args);
+        if (argSize[i] == 0) return 0;
+    }
+
+    // Message order: signer+writable, signer, writable, read-only
+    int order[MAX_KEYS];
+    int position[MAX_KEYS];
+    int ordered = 0;
+    for (int group = 0; group < 4; group++) {
+        for (int i = 0; i < keyCount; i++) {
+            int keyGroup = (keys[i].signer ? 0 : 2) + (keys[i].writable ? 0 : 1);
+            if (keyGroup != group) continue;
+            position[i] = ordered;
+            order[ordered++] = i;
+        }
+    }
+
+    uint8_t numSigners = 0, numReadonlySigned = 0, numReadonlyUnsigned = 0;
+    for (int i = 0; i < keyCount; i++) {
+        if (keys[i].signer) {
+            numSigners++;
+            if (!keys[i].writable) numReadonlySigned++;
+        } else if (!keys[i].writable) {
+            numReadonlyUnsigned++;
+        }
+    }
+
+    // Worst case per instruction is well under this; checked once up front
+    size_t needed = 3 + 3 + keyCount * KEY_SIZE + KEY_SIZE + 3 + 2 * 16;
+    for (int i = 0; i < count; i++) {
+        needed += 1 + 3 + 3 + 2 * componentCount[actions[i].type] + 3 + bolt::DISCRIMINATOR_SIZE + 4 + argSize[i];
+    }
+    if (needed > MAX_MESSAGE_SIZE) return 0;
+
+    uint8_t* p = out;
+    *p++ = numSigners;
+    *p++ = numReadonlySigned;
+    *p++ = numReadonlyUnsigned;
+    p += writeCompactU16(p, keyCount);
+    for (int i = 0; i < keyCount; i++) {
+        if (layout) {
+            for (int v = 0; v < 3; v++) {
+                if (keys[order[i]].bytes == placeholderVictim() + v * KEY_SIZE) {
+                    layout->victimKeyOffset[v] = (int16_t)(p - out);
+                }
+            }
+        }
+        memcpy(p, keys[order[i]].bytes, KEY_SIZE);
+        p += KEY_SIZE;
+    }
+    if (layout) layout->blockhashOffset = (uint16_t)(p - out);
+    memcpy(p, blockhash, KEY_SIZE);
+    p += KEY_SIZE;
+
+    int instructionCount = count + 1 + (unitPrice > 0 ? 1 : 0);
+    p += writeCompactU16(p, instructionCount);
+
+    uint32_t units = unitsPerInstruction * (uint32_t)count;
+    *p++ = (uint8_t)position[budgetIndex];
+    p += writeCompactU16(p, 0);
+    p += writeCompactU16(p, 5);
+    *p++ = SET_COMPUTE_UNIT_LIMIT;
+    memcpy(p, &units, 4);
+    p += 4;
+    if (unitPrice > 0) {
+        *p++ = (uint8_t)position[budgetIndex];
+        p += writeCompactU16(p, 0);
+        p += writeCompactU16(p, 9);
+        *p++ = SET_COMPUTE_UNIT_PRICE;
+        memcpy(p, &unitPrice, 8);
+        p += 8;
+    }
+
+    // World, system, (component program, component) pairs, authority
+    for (int i = 0; i < count; i++) {
+        int components = componentCount[actions[i].type];
+        *p++ = (uint8_t)position[worldProgramIndex];
+        p += writeCompactU16(p, 3 + 2 * components);
+        *p++ = (uint8_t)position[worldIndex];
+        *p++ = (uint8_t)position[systemIndex[i]];
+        for (int c = 0; c < components; c++) {
+            *p++ = (uint8_t)position[programIndex[i][c]];
+            *p++ = (uint8_t)position[componentIndex[i][c]];
+        }
+        *p++ = (uint8_t)position[authorityIndex];
+
+        uint32_t length = (uint32_t)writeArgs(actions[i], args);
+        if (layout) layout->dataLengthOffset = (uint16_t)(p - out);
+        p += writeCompactU16(p, bolt::DISCRIMINATOR_SIZE + 4 + length);
+        memcpy(p, APPLY_DISCRIMINATOR, bolt::DISCRIMINATOR_SIZE);
+        p += bolt::DISCRIMINATOR_SIZE;
+        memcpy(p, &length, 4); // Borsh `bytes` length prefix
+        p += 4;
+        if (layout) layout->argOffset = (uint16_t)(p - out);
+        memcpy(p, args, length);
+        p += length;
+    }
+    return (uint32_t)(p - out);
+}
+
+// Victim, victim health and victim stats keys for an entity, from the
+// account mirror; cached because base58 decoding isn't free
+const uint8_t* TxTemplates::victimKeys(const char* address) {
+    if (!address || !*address) return nullptr;
+    victimClock++;
+    for (int i = 0; i < VICTIM_CACHE_SIZE; i++) {
+        if (strcmp(victims[i].address, address) == 0) {
+            victims[i].lastUsed = victimClock;
+            return victims[i].keys[0];
+        }
+    }
+
+    static const AccountKind kinds[3] = { ACCOUNT_PLAYER, ACCOUNT_HEALTH, ACCOUNT_PLAYER_STATS };
+    uint8_t keys[3][KEY_SIZE];
+    const AccountMirror& mirror = AccountMirror::instance();
+    for (int k = 0; k < 3; k++) {
+        const AccountRecord* record = mirror.findComponent(address, kinds[k]);
+        if (!record || !decodeBase58(record->address, keys[k], KEY_SIZE)) return nullptr;
+    }
+
+    Victim* slot = &victims[0];
+    for (int i = 1; i < VICTIM_CACHE_SIZE; i++) {
+        if (victims[i].lastUsed < slot->lastUsed) slot = &victims[i];
+    }
+    strncpy(slot->address, address, ADDRESS_SIZE - 1);
+    slot->address[ADDRESS_SIZE - 1] = '\0';
+    memcpy(slot->keys, keys, sizeof(keys));
+    slot->lastUsed = victimClock;
+    return slot->keys[0];
+}
+
+const uint8_t* TxTemplates::build(const BatchAction* actions, int count, uint32_t* size) {
+    if (!ready() || count < 1 || count > MAX_INSTRUCTIONS) return nullptr;
+
+    if (count > 1) {
+        // Several instructions share the keys, so the layout is redone; all
+        // the inputs are already decoded, so this is a few hundred bytes of copying
+        *size = compile(actions, count, scratch, nullptr);
+        return *size ? scratch : nullptr;
+    }
+
+    // One instruction: patch the prepared message in place
+    const BatchAction& action = actions[0];
+    if (action.type > BATCH_ACTION_APPLY_DAMAGE) return nullptr;
+    Template& layout = templates[action.type];
+
+    // The arguments end the message; their length only moves the bytes
+    // after them while its compact-u16 keeps the template's width
+    char args[MAX_ARGS_SIZE];
+    uint32_t length = (uint32_t)writeArgs(action, args);
+    if (length == 0) return nullptr;
+    uint8_t dataLength[3];
+    int width = writeCompactU16(dataLength, bolt::DISCRIMINATOR_SIZE + 4 + length);
+    if (layout.dataLengthOffset + width + bolt::DISCRIMINATOR_SIZE + 4 != layout.argOffset ||
+        layout.argOffset + length > (uint32_t)MAX_MESSAGE_SIZE) {
+        *size = compile(&action, 1, scratch, nullptr);
+        return *size ? scratch : nullptr;
+    }
+
+    if (action.type == BATCH_ACTION_APPLY_DAMAGE) {
+        const uint8_t* victim = victimKeys(action.victimAddress);
+        if (!victim) return nullptr;
+        // A victim key already in the message would change the layout; compile() merges it
+        int keyCount = layout.message[3]; // Compact-u16, one byte below 128 keys
+        for (int k = 0; k < keyCount; k++) {
+            int offset = 4 + k * KEY_SIZE;
+            if (offset == layout.victimKeyOffset[0] || offset == layout.victimKeyOffset[1] ||
+                offset == layout.victimKeyOffset[2]) continue;
+            for (int v = 0; v < 3; v++) {
+                if (memcmp(victim + v * KEY_SIZE, layout.message + offset, KEY_SIZE) == 0) {
+                    *size = compile(&action, 1, scratch, nullptr);
+                    return *size ? scratch : nullptr;
+                }
+            }
+        }
+        for (int v = 0; v < 3; v++) {
+            memcpy(layout.message + layout.victimKeyOffset[v], victim + v * KEY_SIZE, KEY_SIZE);
+        }
+    }
+    memcpy(layout.message + layout.blockhashOffset, blockhash, KEY_SIZE);
+    memcpy(layout.message + layout.dataLengthOffset, dataLength, width);
+    memcpy(layout.message + layout.argOffset - 4, &length, 4);
+    memcpy(layout.message + layout.argOffset, args, length);
+    *size = layout.argOffset + length;
+    return layout.message;
+}
+
+#if defined(PLATFORM_WEB) && defined(SOLFPS_TX_TEMPLATES)
+
+extern "C" EMSCRIPTEN_KEEPALIVE int TxTemplatesSetAccount(int account, const char* base58) {
+    return TxTemplates::instance().setAccount((TxAccount)account, base58) ? 1 : 0;
+}
+
+extern "C" EMSCRIPTEN_KEEPALIVE int TxTemplatesSetBlockhash(const char* base58) {
+    return TxTemplates::instance().setBlockhash(base58) ? 1 : 0;
+}
+
+extern "C" EMSCRIPTEN_KEEPALIVE int TxTemplatesPrepare() {
+    return TxTemplates::instance().prepare() ? 1 : 0;
+}
+
+void TxTemplates::connect() {
+    EM_ASM({
+        const bridge = window.SolanaGameBridge;
+        if (!bridge || !bridge.getSessionAccounts || !bridge.getLatestBlockhash || !bridge.sendPreparedTransaction) {
+            console.log('TxTemplates: bridge builds its own instructions');
+            return;
+        }
+
+        // Order matches TxAccount
+        const names = ['authority', 'player', 'weapon', 'position', 'health', 'playerStats', 'game', 'world'];
+        bridge.getSessionAccounts()
+            .then(accounts => {
+                names.forEach((name, index) => {
+                    if (!accounts[name]) return;
+                    const keyPtr = allocateUTF8(accounts[name]);
+                    _TxTemplatesSetAccount(index, keyPtr);
+                    _free(keyPtr);
+                });
+                if (!_TxTemplatesPrepare()) console.warn('TxTemplates: session accounts incomplete');
+            })
+            .catch(err => console.warn('TxTemplates: ' + (err.message || err)));
+
+        const refresh = () => {
+            bridge.getLatestBlockhash()
+                .then(hash => {
+                    const hashPtr = allocateUTF8(hash);
+                    _TxTemplatesSetBlockhash(hashPtr);
+                    _free(hashPtr);
+                })
+                .catch(err => console.warn('TxTemplates: blockhash refresh failed: ' + (err.message || err)));
+        };
+        refresh();
+        if (Module.txTemplatesBlockhashTimer) clearInterval(Module.txTemplatesBlockhashTimer);
+        Module.txTemplatesBlockhashTimer = setInterval(refresh, 20000);
+    });
+}
+
+#else
+
+void TxTemplates::connect() {
+    // Off until a message laid out here has gone through a real cluster or
+    // the JS bridge, so build() stays null and the action queue keeps using
+    // the per-instruction bridge calls. The mock chain takes requests, not
+    // signed messages, either way.
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "ui.h"
 #include <raylib.h>
-#include <string>
+#include <cstring>
+#include "frame_arena.h"
 
 void UI::drawCrosshair(int screenWidth, int screenHeight) {
     int centerX = screenWidth / 2;
@@ -33,7 +34,7 @@ void UI::drawReticle(int screenWidth, int screenHeight, bool shooting) {
     }
 }
 
-void UI::drawGunHUD(int ammo, int maxAmmo, int screenWidth, int screenHeight) {
+void UI::drawGunHUD(const char* weaponName, int ammo, int maxAmmo, int screenWidth, int screenHeight) {
     int hudX = screenWidth - 150;
     int hudY = screenHeight - 80;
     
@@ -42,12 +43,13 @@ void UI::drawGunHUD(int ammo, int maxAmmo, int screenWidth, int screenHeight) {
     DrawRectangleLines(hudX - 10, hudY - 10, 140, 70, (Color){ 0, 255, 255, 255 });
     
     // Ammo text
-    DrawText(TextFormat("%d", ammo), hudX, hudY, 40, 
+    FrameArena& arena = FrameArena::frame();
+    DrawText(arena.format("%d", ammo), hudX, hudY, 40, 
              ammo > 10 ? (Color){ 0, 255, 100, 255 } : RED);
-    DrawText(TextFormat("/ %d", maxAmmo), hudX + 60, hudY + 15, 20, LIGHTGRAY);
+    DrawText(arena.format("/ %d", maxAmmo), hudX + 60, hudY + 15, 20, LIGHTGRAY);
     
-    // Ammo label
-    DrawText("AMMO", hudX + 20, hudY + 45, 10, DARKGRAY);
+    // Weapon label
+    DrawText(weaponName, hudX + 20, hudY + 45, 10, DARKGRAY);
 }
 
 void UI::drawHealthBar(float health, float maxHealth, int screenWidth, int screenHeight) {
@@ -119,11 +121,13 @@ void UI::drawHealthBar(float health, float maxHealth, int screenWidth, int scree
                       (Color){ 0, 200, 255, 150 });
     
     // Health text with shadow
-    DrawText(TextFormat("%.0f", health), barX + 8, barY + 6, 20, (Color){ 0, 0, 0, 200 });
-    DrawText(TextFormat("%.0f", health), barX + 7, barY + 5, 20, WHITE);
+    FrameArena& arena = FrameArena::frame();
+    const char* healthText = arena.format("%.0f", health);
+    DrawText(healthText, barX + 8, barY + 6, 20, (Color){ 0, 0, 0, 200 });
+    DrawText(healthText, barX + 7, barY + 5, 20, WHITE);
     
     // Max health indicator
-    DrawText(TextFormat("/ %.0f", maxHealth), barX + 60, barY + 9, 14, (Color){ 150, 150, 170, 255 });
+    DrawText(arena.format("/ %.0f", maxHealth), barX + 60, barY + 9, 14, (Color){ 150, 150, 170, 255 });
     
     // "HEALTH" label with glow
     DrawText("HEALTH", barX + barWidth - 65, barY + 9, 12, (Color){ 0, 255, 255, 200 });
@@ -136,7 +140,7 @@ void UI::drawHealthBar(float health, float maxHealth, int screenWidth, int scree
     }
 }
 
-void UI::drawWalletInfo(bool connected, const std::string& address, double balance) {
+void UI::drawWalletInfo(bool connected, const char* address, double balance) {
     int x = 20;
     int y = 20;
     int width = 300;
@@ -148,16 +152,19 @@ void UI::drawWalletInfo(bool connected, const std::string& address, double balan
     DrawText("WALLET", x + 10, y + 10, 12, (Color){ 138, 43, 226, 255 });
     
     if (connected) {
+        FrameArena& arena = FrameArena::frame();
         DrawText("Status: CONNECTED", x + 10, y + 30, 10, (Color){ 0, 255, 100, 255 });
         
-        if (!address.empty()) {
-            std::string truncated = address.length() > 20 
-                ? address.substr(0, 8) + "..." + address.substr(address.length() - 6)
+        size_t length = strlen(address);
+        if (length > 0) {
+            // Truncate long addresses to "ABCDEFGH...UVWXYZ"
+            const char* truncated = length > 20
+                ? arena.format("%.8s...%s", address, address + length - 6)
                 : address;
-            DrawText(truncated.c_str(), x + 10, y + 48, 9, LIGHTGRAY);
+            DrawText(truncated, x + 10, y + 48, 9, LIGHTGRAY);
         }
         
-        DrawText(TextFormat("%.4f SOL", balance / 1000000000.0), x + 10, y + 65, 10, 
+        DrawText(arena.format("%.4f SOL", balance / 1000000000.0), x + 10, y + 65, 10, 
                 (Color){ 0, 200, 255, 255 });
     } else {
         DrawText("Status: NOT CONNECTED", x + 10, y + 30, 10, RED);
@@ -169,8 +176,8 @@ void UI::drawControls() {
     int x = 20;
     int y = 120;
     
-    DrawRectangle(x, y, 200, 150, Fade((Color){ 20, 20, 30, 255 }, 0.7f));
-    DrawRectangleLines(x, y, 200, 150, (Color){ 0, 200, 255, 255 });
+    DrawRectangle(x, y, 200, 165, Fade((Color){ 20, 20, 30, 255 }, 0.7f));
+    DrawRectangleLines(x, y, 200, 165, (Color){ 0, 200, 255, 255 });
     
     DrawText("CONTROLS", x + 10, y + 8, 10, (Color){ 0, 200, 255, 255 });
     DrawText("WASD - Move", x + 10, y + 25, 9, LIGHTGRAY);
@@ -179,6 +186,162 @@ void UI::drawControls() {
     DrawText("SPACE - Jump", x + 10, y + 70, 9, LIGHTGRAY);
     DrawText("MOUSE - Look", x + 10, y + 85, 9, LIGHTGRAY);
     DrawText("LEFT CLICK - Shoot", x + 10, y + 100, 9, LIGHTGRAY);
-    DrawText("R - Reload", x + 10, y + 115, 9, LIGHTGRAY);
-    DrawText("ESC - Unlock Cursor", x + 10, y + 130, 9, LIGHTGRAY);
+    DrawText("1 / 2 / WHEEL - Switch Weapon", x + 10, y + 115, 9, LIGHTGRAY);
+    DrawText("R - Reload", x + 10, y + 130, 9, LIGHTGRAY);
+    DrawText("ESC - Unlock Cursor", x + 10, y + 145, 9, LIGHTGRAY);
+}
+
+void UI::drawNetworkStats(const ActionQueueStats& stats, const MovementSyncStats& movement,
+                          const WeaponPrediction& weapon, const BridgeEventStats& events, int screenWidth) {
+    int width = 200;
+    int x = screenWidth - width - 20;
+    int y = 40;
+    
+    DrawRectangle(x, y, width, 155, Fade((Color){ 20, 20, 30, 255 }, 0.8f));
+    DrawRectangleLines(x, y, width, 155, (Color){ 0, 255, 100, 255 });
+    
+    FrameArena& arena = FrameArena::frame();
+    DrawText("NETWORK", x + 10, y + 8, 10, (Color){ 0, 255, 100, 255 });
+    DrawText(arena.format("Queued: %d / %d", stats.depth, ActionQueue::CAPACITY), x + 10, y + 25, 9, LIGHTGRAY);
+    DrawText(arena.format("In flight: %d  Timed out: %u", stats.inFlight, stats.timedOut), x + 10, y + 40, 9,
+             stats.timedOut > 0 ? ORANGE : LIGHTGRAY);
+    DrawText(arena.format("Sent: %u  OK: %u  Failed: %u", stats.sent, stats.succeeded, stats.failed),
+             x + 10, y + 55, 9, LIGHTGRAY);
+    DrawText(arena.format("Coalesced: %u", stats.coalesced), x + 10, y + 70, 9, LIGHTGRAY);
+    DrawText(arena.format("Dropped: %u", stats.dropped), x + 10, y + 85, 9,
+             stats.dropped > 0 ? ORANGE : LIGHTGRAY);
+    DrawText(arena.format("Movement: %u / %u ticks  (err %.2f)", movement.sent, movement.ticks, movement.lastError),
+             x + 10, y + 100, 9, LIGHTGRAY);
+    const WeaponPredictionStats& prediction = weapon.stats();
+    DrawText(arena.format("Predicted: %d pending  %u rolled back  %u fixed", weapon.pending(),
+                          prediction.rolledBack, prediction.corrections),
+             x + 10, y + 115, 9, prediction.rolledBack > 0 ? ORANGE : LIGHTGRAY);
+    DrawText(arena.format("Callbacks: %u this frame  peak %u", events.lastDispatch, events.peakDepth),
+             x + 10, y + 130, 9, events.refused > 0 ? ORANGE : LIGHTGRAY);
+}
+
+void UI::drawScoreboard(const PlayerRoster& roster, int screenWidth, int screenHeight) {
+    int width = 420;
+    int rowHeight = 18;
+    int height = 60 + rowHeight * (roster.count() > 0 ? roster.count() : 1);
+    int x = (screenWidth - width) / 2;
+    int y = (screenHeight - height) / 3;
+
+    DrawRectangle(x, y, width, height, Fade((Color){ 20, 20, 30, 255 }, 0.85f));
+    DrawRectangleLines(x, y, width, height, (Color){ 0, 255, 255, 255 });
+    DrawText("SCOREBOARD", x + 10, y + 10, 16, (Color){ 0, 255, 255, 255 });
+    DrawText("PLAYER", x + 10, y + 35, 10, GRAY);
+    DrawText("K", x + 260, y + 35, 10, GRAY);
+    DrawText("D", x + 310, y + 35, 10, GRAY);
+    DrawText("HP", x + 360, y + 35, 10, GRAY);
+
+    if (roster.count() == 0) {
+        DrawText("Waiting for account updates...", x + 10, y + 52, 10, LIGHTGRAY);
+        return;
+    }
+
+    // Team A first, then team B; the roster is small, so two passes beat sorting
+    FrameArena& arena = FrameArena::frame();
+    int row = 0;
+    for (int team = 0; team < 2; team++) {
+        for (int i = 0; i < roster.count(); i++) {
+            const RosterEntry& entry = roster.entry(i);
+            if (entry.team != team) continue;
+            int rowY = y + 52 + row++ * rowHeight;
+            Color color = team == 0 ? (Color){ 0, 200, 255, 255 } : (Color){ 255, 0, 150, 255 };
+            if (!entry.alive) color = GRAY;
+            DrawText(entry.local ? arena.format("%s (you)", entry.name) : entry.name, x + 10, rowY, 10, color);
+            DrawText(arena.format("%u", entry.kills), x + 260, rowY, 10, LIGHTGRAY);
+            DrawText(arena.format("%u", entry.deaths), x + 310, rowY, 10, LIGHTGRAY);
+            DrawText(arena.format("%u", entry.health), x + 360, rowY, 10, LIGHTGRAY);
+        }
+    }
+}
+
+void UI::drawBridgeLatency(const BridgeLatency& latency, int screenWidth, int screenHeight) {
+    int width = 340;
+    int rowHeight = 13;
+    int x = screenWidth - width - 20;
+    int y = 205;
+
+    int rows = 0;
+    int failureRows = 0;
+    for (int i = 0; i < BRIDGE_INSTRUCTION_COUNT; i++) {
+        const BridgeInstructionLatency& entry = latency.instruction(i);
+        if (entry.histogram.count() == 0 && entry.failed == 0) continue;
+        rows++;
+        failureRows += entry.failureKinds;
+    }
+    if (failureRows > 8) failureRows = 8;
+    int height = 45 + rowHeight * (rows > 0 ? rows : 1) + (failureRows > 0 ? 8 + rowHeight * failureRows : 0);
+    if (y + height > screenHeight - 20) height = screenHeight - 20 - y;
+
+    DrawRectangle(x, y, width, height, Fade((Color){ 20, 20, 30, 255 }, 0.8f));
+    DrawRectangleLines(x, y, width, height, (Color){ 255, 200, 0, 255 });
+    DrawText("BRIDGE LATENCY (ms)  F5 export", x + 10, y + 8, 10, (Color){ 255, 200, 0, 255 });
+
+    static const int columns[] = { 10, 110, 150, 190, 230, 275, 310 };
+    static const char* headings[] = { "CALL", "N", "P50", "P95", "P99", "MAX", "FAIL" };
+    for (int c = 0; c < 7; c++) {
+        DrawText(headings[c], x + columns[c], y + 25, 9, GRAY);
+    }
+    if (rows == 0) {
+        DrawText("No bridge calls yet", x + 10, y + 40, 9, LIGHTGRAY);
+        return;
+    }
+
+    FrameArena& arena = FrameArena::frame();
+    int rowY = y + 40;
+    for (int i = 0; i < BRIDGE_INSTRUCTION_COUNT; i++) {
+        const BridgeInstructionLatency& entry = latency.instruction(i);
+        const LatencyHistogram& histogram = entry.histogram;
+        if (histogram.count() == 0 && entry.failed == 0) continue;
+        if (rowY + rowHeight > y + height) return;
+
+        DrawText(BridgeLatency::instructionName(i), x + columns[0], rowY, 9, LIGHTGRAY);
+        DrawText(arena.format("%llu", (unsigned long long)histogram.count()), x + columns[1], rowY, 9, LIGHTGRAY);
+        DrawText(arena.format("%.0f", histogram.percentile(50.0) / 1000.0), x + columns[2], rowY, 9, LIGHTGRAY);
+        DrawText(arena.format("%.0f", histogram.percentile(95.0) / 1000.0), x + columns[3], rowY, 9, LIGHTGRAY);
+        DrawText(arena.format("%.0f", histogram.percentile(99.0) / 1000.0), x + columns[4], rowY, 9, ORANGE);
+        DrawText(arena.format("%.0f", histogram.max() / 1000.0), x + columns[5], rowY, 9, LIGHTGRAY);
+        DrawText(arena.format("%u", entry.failed), x + columns[6], rowY, 9, entry.failed > 0 ? RED : LIGHTGRAY);
+        rowY += rowHeight;
+    }
+
+    // Most useful when something is failing: which calls, and why
+    rowY += 8;
+    int shown = 0;
+    for (int i = 0; i < BRIDGE_INSTRUCTION_COUNT && shown < failureRows; i++) {
+        const BridgeInstructionLatency& entry = latency.instruction(i);
+        for (int j = 0; j < entry.failureKinds && shown < failureRows; j++, shown++) {
+            if (rowY + rowHeight > y + height) return;
+            DrawText(arena.format("%s: %s x%u", BridgeLatency::instructionName(i), entry.failures[j].error,
+                                  entry.failures[j].count),
+                     x + 10, rowY, 9, ORANGE);
+            rowY += rowHeight;
+        }
+    }
+}
+
+void UI::drawLoadingScreen(float progress, const char* pending, int screenWidth, int screenHeight) {
+    int barWidth = 400;
+    int barHeight = 16;
+    int barX = (screenWidth - barWidth) / 2;
+    int barY = screenHeight / 2;
+    
+    ClearBackground((Color){ 5, 5, 10, 255 });
+    
+    const char* title = "LOADING ARENA";
+    DrawText(title, (screenWidth - MeasureText(title, 30)) / 2, barY - 60, 30, (Color){ 0, 255, 255, 255 });
+    
+    // Frame and fill, same palette as the health bar
+    DrawRectangle(barX, barY, barWidth, barHeight, (Color){ 20, 20, 30, 230 });
+    DrawRectangle(barX, barY, (int)(barWidth * progress), barHeight, (Color){ 0, 255, 150, 255 });
+    DrawRectangleLines(barX - 3, barY - 3, barWidth + 6, barHeight + 6, (Color){ 0, 255, 255, 150 });
+    
+    // Whatever is still outstanding, so a slow asset is visible
+    if (pending && pending[0]) {
+        const char* line = TextFormat("%s...", pending);
+        DrawText(line, (screenWidth - MeasureText(line, 16)) / 2, barY + 30, 16, (Color){ 150, 150, 170, 255 });
+    }
 }
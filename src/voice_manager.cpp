@@ -0,0 +1,132 @@
+#include "voice_manager.h"
+#include <cstring>
+
+VoiceManager& VoiceManager::instance() {
+    static VoiceManager manager;
+    return manager;
+}
+
+VoiceManager::VoiceManager() {
+    memset(voices, 0, sizeof(voices));
+    playCount = 0;
+    memset(&totals, 0, sizeof(totals));
+}
+
+// Aliases of one sound share its samples but each has its own buffer,
+// which is what identifies a voice
+int VoiceManager::findVoice(const Sound& sound) const {
+    for (int i = 0; i < MAX_VOICES; i++) {
+        if (voices[i].active && voices[i].sound.stream.buffer == sound.stream.buffer) return i;
+    }
+    return -1;
+}
+
+// Lowest priority, then quietest, then oldest
+int VoiceManager::pickVictim() const {
+    int victim = -1;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        const Voice& voice = voices[i];
+        if (!voice.active) continue;
+        if (victim < 0) {
+            victim = i;
+            continue;
+        }
+        const Voice& best = voices[victim];
+        if (voice.priority != best.priority) {
+            if (voice.priority < best.priority) victim = i;
+        } else if (voice.volume != best.volume) {
+            if (voice.volume < best.volume) victim = i;
+        } else if ((int32_t)(voice.startedAt - best.startedAt) < 0) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+void VoiceManager::start(int index, const Sound& sound, VoicePriority priority, float volume, float pan) {
+    Voice& voice = voices[index];
+    voice.active = true;
+    voice.sound = sound;
+    voice.priority = priority;
+    voice.volume = volume;
+    voice.startedAt = playCount++;
+    SetSoundVolume(sound, volume);
+    SetSoundPan(sound, pan);
+    PlaySound(sound);
+    totals.played++;
+}
+
+bool VoiceManager::play(const Sound* aliases, int aliasCount, VoicePriority priority, float volume, float pan) {
+    if (aliasCount <= 0 || !aliases[0].stream.buffer) return false;
+    if (volume < AUDIBLE_VOLUME) {
+        totals.culled++;
+        return false;
+    }
+
+    // A free alias needs a voice; with none free, restart the alias that
+    // has played longest, keeping its voice
+    int alias = -1;
+    int restart = -1;
+    for (int i = 0; i < aliasCount; i++) {
+        if (!IsSoundPlaying(aliases[i])) {
+            alias = i;
+            break;
+        }
+        int voice = findVoice(aliases[i]);
+        if (voice >= 0 && (restart < 0 || (int32_t)(voices[voice].startedAt - voices[restart].startedAt) < 0)) {
+            restart = voice;
+        }
+    }
+    if (alias < 0 && restart >= 0) {
+        const Sound sound = voices[restart].sound;
+        StopSound(sound);
+        start(restart, sound, priority, volume, pan);
+        return true;
+    }
+    if (alias < 0) alias = 0;    // Playing outside the manager; take it over
+
+    for (int i = 0; i < MAX_VOICES; i++) {
+        if (!voices[i].active || !IsSoundPlaying(voices[i].sound)) {
+            start(i, aliases[alias], priority, volume, pan);
+            return true;
+        }
+    }
+
+    int victim = pickVictim();
+    const Voice& loser = voices[victim];
+    if (loser.priority > priority || (loser.priority == priority && loser.volume > volume)) {
+        totals.rejected++;
+        return false;
+    }
+    StopSound(loser.sound);
+    totals.stolen++;
+    start(victim, aliases[alias], priority, volume, pan);
+    return true;
+}
+
+bool VoiceManager::play(SoundId sound, VoicePriority priority, float volume, float pan) {
+    int count = 0;
+    const Sound* aliases = SoundBank::instance().instances(sound, count);
+    return play(aliases, count, priority, volume, pan);
+}
+
+void VoiceManager::update() {
+    int active = 0;
+    for (int i = 0; i < MAX_VOICES; i++) {
+        Voice& voice = voices[i];
+        if (!voice.active) continue;
+        if (IsSoundPlaying(voice.sound)) active++;
+        else voice.active = false;
+    }
+    totals.active = active;
+    if (active > totals.peak) totals.peak = active;
+}
+
+void VoiceManager::release(const Sound* aliases, int aliasCount) {
+    for (int i = 0; i < aliasCount; i++) {
+        int voice = findVoice(aliases[i]);
+        if (voice < 0) continue;
+        StopSound(voices[voice].sound);
+        voices[voice].active = false;
+    }
+}
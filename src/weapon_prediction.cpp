@@ -0,0 +1,210 @@
+#include "weapon_prediction.h"
+#include <cstring>
+
+WeaponPrediction::WeaponPrediction(int primaryMagazine, int secondaryMagazine) {
+    capacity[0] = primaryMagazine;
+    capacity[1] = secondaryMagazine;
+    for (int i = 0; i < SLOTS; i++) {
+        base.ammo[i] = capacity[i];
+        base.reserve[i] = DEFAULT_RESERVE;
+    }
+    predicted = base;
+    pendingActions = 0;
+    authority = false;
+    authoritySlot = 0;
+    memset(&totals, 0, sizeof(totals));
+
+    ActionQueue::instance().addResultListener(onResult, this);
+    AccountMirror::instance().subscribe(ACCOUNT_WEAPON, onWeaponChanged, this);
+}
+
+WeaponPrediction::~WeaponPrediction() {
+    ActionQueue::instance().removeResultListener(onResult, this);
+    AccountMirror::instance().unsubscribe(onWeaponChanged, this);
+}
+
+int WeaponPrediction::ammo(uint8_t slot) const {
+    return slot >= 1 && slot <= SLOTS ? predicted.ammo[slot - 1] : 0;
+}
+
+int WeaponPrediction::reserve(uint8_t slot) const {
+    return slot >= 1 && slot <= SLOTS ? predicted.reserve[slot - 1] : 0;
+}
+
+int WeaponPrediction::magazine(uint8_t slot) const {
+    return slot >= 1 && slot <= SLOTS ? capacity[slot - 1] : 0;
+}
+
+bool WeaponPrediction::shoot(uint8_t slot) {
+    return predict(BATCH_ACTION_SHOOT, slot);
+}
+
+bool WeaponPrediction::reload(uint8_t slot) {
+    return predict(BATCH_ACTION_RELOAD, slot);
+}
+
+// Mirrors the contract's checks and effects, so a replay matches what the
+// chain will do with the same actions
+bool WeaponPrediction::apply(WeaponState& state, uint8_t type, uint8_t slot) const {
+    if (slot < 1 || slot > SLOTS) return false;
+    int index = slot - 1;
+    if (type == BATCH_ACTION_SHOOT) {
+        if (state.ammo[index] <= 0) return false;
+        state.ammo[index]--;
+        return true;
+    }
+    if (type == BATCH_ACTION_RELOAD) {
+        int moved = capacity[index] - state.ammo[index];
+        if (moved > state.reserve[index]) moved = state.reserve[index];
+        if (moved <= 0) return false;
+        state.ammo[index] += moved;
+        state.reserve[index] -= moved;
+        return true;
+    }
+    return false;
+}
+
+bool WeaponPrediction::predict(uint8_t type, uint8_t slot) {
+    WeaponState next = predicted;
+    if (!apply(next, type, slot)) return false;
+
+    ActionQueue& queue = ActionQueue::instance();
+    ActionId id = type == BATCH_ACTION_SHOOT ? queue.enqueueShoot(slot) : queue.enqueueReload(slot);
+
+    if (id == 0) {
+        // Not going to the chain: offline, the local state is all there is;
+        // otherwise the chain will never see it, so neither should the player
+        if (queue.isEnabled() && authority) return false;
+        apply(base, type, slot);
+        predicted = next;
+        return true;
+    }
+
+    // A reload merged into one still waiting is already counted
+    for (int i = 0; i < pendingActions; i++) {
+        if (actions[i].id == id) return true;
+    }
+
+    if (pendingActions == MAX_PENDING) {
+        // Can't track it; treat it as confirmed rather than lose it
+        apply(base, type, slot);
+        predicted = next;
+        return true;
+    }
+
+    PendingAction& action = actions[pendingActions++];
+    action.id = id;
+    action.type = type;
+    action.slot = slot;
+    action.confirmed = false;
+    action.confirmedAfter = 0;
+    action.confirmedAge = 0.0f;
+    predicted = next;
+    totals.predicted++;
+    return true;
+}
+
+void WeaponPrediction::remove(int index) {
+    // Order matters for the replay, so shift rather than swap
+    memmove(&actions[index], &actions[index + 1], (pendingActions - index - 1) * sizeof(PendingAction));
+    pendingActions--;
+}
+
+void WeaponPrediction::replay() {
+    predicted = base;
+    for (int i = 0; i < pendingActions; i++) {
+        apply(predicted, actions[i].type, actions[i].slot);
+    }
+}
+
+void WeaponPrediction::update(float deltaTime) {
+    bool expired = false;
+    for (int i = 0; i < pendingActions; i++) {
+        if (!actions[i].confirmed) continue;
+        actions[i].confirmedAge += deltaTime;
+        if (actions[i].confirmedAge < CONFIRM_TIMEOUT) continue;
+
+        // The feed missed it or it arrived before the confirmation; either
+        // way the base is as good as it gets
+        remove(i--);
+        expired = true;
+    }
+    if (expired) replay();
+}
+
+void WeaponPrediction::onResult(ActionId id, uint8_t type, bool success, const char* error, void* user) {
+    (void)error;
+    if (type != BATCH_ACTION_SHOOT && type != BATCH_ACTION_RELOAD) return;
+    WeaponPrediction* weapon = static_cast<WeaponPrediction*>(user);
+
+    for (int i = 0; i < weapon->pendingActions; i++) {
+        PendingAction& action = weapon->actions[i];
+        if (action.id != id) continue;
+
+        if (!success) {
+            weapon->totals.rolledBack++;
+            weapon->remove(i);
+            weapon->replay();
+        } else if (!weapon->authority) {
+            // No account feed to wait for; the confirmation is the authority
+            weapon->totals.confirmed++;
+            weapon->apply(weapon->base, action.type, action.slot);
+            weapon->remove(i);
+            weapon->replay();
+        } else {
+            weapon->totals.confirmed++;
+            action.confirmed = true;
+            action.confirmedAfter = weapon->authoritySlot;
+        }
+        return;
+    }
+}
+
+void WeaponPrediction::onWeaponChanged(const AccountRecord& record, void* user) {
+    WeaponPrediction* weapon = static_cast<WeaponPrediction*>(user);
+    if (!AccountMirror::instance().isLocalEntity(record.entity)) return;
+    if (weapon->authority && record.slot <= weapon->authoritySlot) return;
+
+    bolt::WeaponView view;
+    if (!record.view(view)) return;
+
+    WeaponState before = weapon->predicted;
+    WeaponState previous = weapon->base;
+    bool hadAuthority = weapon->authority;
+    weapon->base.ammo[0] = (int)view.primaryAmmo();
+    weapon->base.reserve[0] = (int)view.primaryAmmoReserve();
+    weapon->base.ammo[1] = (int)view.secondaryAmmo();
+    weapon->base.reserve[1] = (int)view.secondaryAmmoReserve();
+    weapon->authority = true;
+    weapon->authoritySlot = record.slot;
+
+    // Updates and confirmations race, so an update may include actions not
+    // confirmed yet: drop the longest run of oldest actions that, replayed
+    // onto the previous state, gives exactly this one
+    int included = -1;
+    if (hadAuthority) {
+        WeaponState state = previous;
+        if (memcmp(&state, &weapon->base, sizeof(WeaponState)) == 0) included = 0;
+        for (int i = 0; i < weapon->pendingActions; i++) {
+            weapon->apply(state, weapon->actions[i].type, weapon->actions[i].slot);
+            if (memcmp(&state, &weapon->base, sizeof(WeaponState)) == 0) included = i + 1;
+        }
+    }
+    if (included >= 0) {
+        memmove(&weapon->actions[0], &weapon->actions[included], (weapon->pendingActions - included) * sizeof(PendingAction));
+        weapon->pendingActions -= included;
+    } else {
+        // Something else changed it (respawn, an action that failed, a missed
+        // update): anything confirmed before this slot is in it
+        for (int i = 0; i < weapon->pendingActions; i++) {
+            if (weapon->actions[i].confirmed && weapon->actions[i].confirmedAfter < record.slot) {
+                weapon->remove(i--);
+            }
+        }
+    }
+    weapon->replay();
+
+    if (memcmp(&before, &weapon->predicted, sizeof(WeaponState)) != 0) {
+        weapon->totals.corrections++;
+    }
+}
@@ -0,0 +1,83 @@
+#include "weapons.h"
+#include <raymath.h>
+#include <cmath>
+#include <utility>
+#include "player.h"
+#include "gun.h"
+#include "effects.h"
+#include "projectiles.h"
+#include "hitboxes.h"
+#include "player_roster.h"
+#include "action_queue.h"
+
+// A direction within `spread` radians of `forward`, uniform over the cone's cross-section
+static Vector3 scatter(Vector3 forward, float spread) {
+    Vector3 side = fabsf(forward.y) < 0.99f ? (Vector3){ 0.0f, 1.0f, 0.0f } : (Vector3){ 1.0f, 0.0f, 0.0f };
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, side));
+    Vector3 up = Vector3CrossProduct(right, forward);
+    float radius = spread * sqrtf(GetRandomValue(0, 10000) / 10000.0f);
+    float angle = GetRandomValue(0, 6283) / 1000.0f;
+    Vector3 offset = Vector3Add(Vector3Scale(right, cosf(angle) * radius), Vector3Scale(up, sinf(angle) * radius));
+    return Vector3Normalize(Vector3Add(forward, offset));
+}
+
+// One shot of weapon W. Every number comes from its row of WEAPONS as a
+// constant, and the archetype's branch is resolved when this is compiled.
+template <WeaponId W>
+static void fire(ShotContext& shot) {
+    constexpr const WeaponDef& def = WEAPONS[W];
+    Player& player = *shot.player;
+
+    // Predicted now, rolled back if the transaction fails
+    if (!player.weapon.shoot(def.slot)) return;
+    player.ammo = player.weapon.ammo(def.slot);
+    player.shootCooldown = def.cooldown();
+
+    // The view climbs through the pattern while the trigger stays down
+    double now = GetTime();
+    if (now - player.lastShotTime > def.recoil.resetTime) player.recoilShot = 0;
+    int step = player.recoilShot < RECOIL_STEPS - 1 ? player.recoilShot : RECOIL_STEPS - 1;
+    player.pitch += def.recoil.pitch[step];
+    player.yaw += def.recoil.yaw[step];
+    player.recoilShot++;
+    player.lastShotTime = now;
+    shot.gun->applyRecoil(def.recoil.gunKick, def.effect.flashScale, shot.gun->shootSounds[W], def.effect.volume);
+
+    Vector3 direction = shot.forward;
+    if constexpr (def.spread > 0.0f) {
+        direction = scatter(direction, def.spread);
+    }
+
+    if constexpr (def.archetype == ARCHETYPE_HITSCAN) {
+        // Nearest of the walls and the other players' hitboxes
+        ShotHit hit = shot.targets->raycast((Ray){ shot.muzzle, direction }, def.range, shot.map);
+        if (hit.region != HIT_NONE) {
+            shot.effects->spawnImpact(hit.point);
+        }
+        if (hit.player >= 0) {
+            ActionQueue::instance().enqueueApplyDamage(shot.roster->entry(hit.player).entity, def.slot,
+                                                       hit.region == HIT_HEAD, hit.distance);
+        }
+        if constexpr (def.effect.tracer) {
+            shot.effects->spawnTracer(shot.muzzle, hit.point);
+        }
+    } else {
+        // Lands in a later step; Projectiles reports the hit
+        shot.projectiles->spawn(shot.muzzle, Vector3Scale(direction, def.muzzleSpeed), def.gravity, def.slot);
+    }
+}
+
+struct FireTable {
+    FireFunction functions[WEAPON_COUNT];
+};
+
+template <size_t... W>
+static constexpr FireTable makeFireTable(std::index_sequence<W...>) {
+    return { { &fire<(WeaponId)W>... } };
+}
+
+static constexpr FireTable fireTable = makeFireTable(std::make_index_sequence<WEAPON_COUNT>());
+
+FireFunction fireFunction(WeaponId weapon) {
+    return fireTable.functions[weapon];
+}
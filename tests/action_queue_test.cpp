@@ -0,0 +1,216 @@
+// Checks of the ActionQueue rules gameplay code relies on, against the mock
+// chain. Answers only land when a check polls the chain, so each one decides
+// what is still in flight. Exits nonzero if any check fails.
+
+#include <cstdio>
+#include <cstring>
+#include "action_queue.h"
+#include "bridge_events.h"
+#include "bridge_latency.h"
+#include "native_bridge.h"
+#include "mock_chain.h"
+
+static int failures = 0;
+
+static void check(const char* name, bool ok) {
+    printf("%-52s %s\n", name, ok ? "ok" : "FAILED");
+    if (!ok) failures++;
+}
+
+// Every result the queue reports, in order
+struct Results {
+    static const int MAX = 64;
+    ActionId ids[MAX];
+    bool success[MAX];
+    char errors[MAX][64];
+    int count;
+
+    int find(ActionId id) const {
+        int matches = 0;
+        for (int i = 0; i < count; i++) matches += ids[i] == id;
+        return matches;
+    }
+};
+
+static void onResult(ActionId id, uint8_t type, bool success, const char* error, void* user) {
+    (void)type;
+    Results& results = *static_cast<Results*>(user);
+    if (results.count == Results::MAX) return;
+    results.ids[results.count] = id;
+    results.success[results.count] = success;
+    strncpy(results.errors[results.count], error ? error : "", sizeof(results.errors[0]) - 1);
+    results.errors[results.count][sizeof(results.errors[0]) - 1] = '\0';
+    results.count++;
+}
+
+// Lands every transaction the chain holds and runs their callbacks
+static void deliverAnswers() {
+    MockChain& chain = MockChain::instance();
+    chain.poll(chain.now() + 10.0);
+    BridgeEvents::instance().dispatch();
+}
+
+static void restart(ActionQueue& queue) {
+    queue.setEnabled(false);
+    queue.setEnabled(true);
+}
+
+// Only the newest movement matters: a second one replaces the first in place
+static void checkMovementCoalescing(ActionQueue& queue) {
+    restart(queue);
+    ActionQueueStats before = queue.stats();
+    ActionId first = queue.enqueueMovement((Vector3){ 1.0f, 0.0f, 1.0f }, 0.0f, (Vector3){ 0.0f, 0.0f, 0.0f });
+    ActionId second = queue.enqueueMovement((Vector3){ 5.0f, 0.0f, 7.0f }, 0.5f, (Vector3){ 1.0f, 0.0f, 0.0f });
+    ActionQueueStats after = queue.stats();
+    check("ActionQueue/movement coalesces",
+          first && second == first && after.depth == 1 && after.coalesced - before.coalesced == 1);
+
+    queue.pump(BridgeLatency::now());
+    deliverAnswers();
+    const MockEntity& self = MockChain::instance().entity(MockChain::LOCAL_PLAYER);
+    check("ActionQueue/movement sends the newest", self.position.x == 5.0f && self.position.z == 7.0f);
+}
+
+// Only the last selected slot matters
+static void checkSwitchCoalescing(ActionQueue& queue) {
+    restart(queue);
+    ActionQueueStats before = queue.stats();
+    ActionId first = queue.enqueueSwitchWeapon(2);
+    ActionId second = queue.enqueueSwitchWeapon(1);
+    ActionId third = queue.enqueueSwitchWeapon(2);
+    ActionQueueStats after = queue.stats();
+    check("ActionQueue/switch weapon coalesces",
+          first && second == first && third == first && after.depth == 1 && after.coalesced - before.coalesced == 2);
+
+    queue.pump(BridgeLatency::now());
+    deliverAnswers();
+    check("ActionQueue/switch weapon sends the last slot",
+          MockChain::instance().entity(MockChain::LOCAL_PLAYER).weapon.currentWeapon == 2);
+}
+
+// Reload, shots, reload while nothing is sent: the second reload refills
+// what the shots spent, so it must be kept, while a third straight after it
+// merges. A reload for the other slot is its own action.
+static void checkReloadMerging(ActionQueue& queue) {
+    restart(queue);
+    ActionQueueStats before = queue.stats();
+    ActionId first = queue.enqueueReload(1);
+    queue.enqueueShoot(1);
+    queue.enqueueShoot(1);
+    queue.enqueueShoot(2);
+    ActionId second = queue.enqueueReload(1);
+    ActionId third = queue.enqueueReload(1);
+    ActionId other = queue.enqueueReload(2);
+    ActionQueueStats after = queue.stats();
+    check("ActionQueue/reload after shots is kept",
+          first && second && second != first && third == second && other && other != second &&
+          after.depth == 6 && after.coalesced - before.coalesced == 1);
+    restart(queue);
+}
+
+// A held trigger fills the queue up to STATE_RESERVE short of CAPACITY;
+// the rest is left for state updates
+static void checkStateReserve(ActionQueue& queue) {
+    restart(queue);
+    ActionQueueStats before = queue.stats();
+    bool shotsTaken = true;
+    for (int i = 0; i < ActionQueue::CAPACITY - ActionQueue::STATE_RESERVE; i++) {
+        shotsTaken = shotsTaken && queue.enqueueShoot(1) != 0;
+    }
+    ActionId extraShot = queue.enqueueShoot(1);
+    ActionId damage = queue.enqueueApplyDamage("victim", 1, false, 10.0f);
+    check("ActionQueue/shots stop at the state reserve",
+          shotsTaken && extraShot == 0 && damage == 0 && queue.stats().dropped - before.dropped == 2);
+
+    ActionId movement = queue.enqueueMovement((Vector3){ 0.0f, 0.0f, 0.0f }, 0.0f, (Vector3){ 0.0f, 0.0f, 0.0f });
+    ActionId weaponSwitch = queue.enqueueSwitchWeapon(2);
+    ActionId reload = queue.enqueueReload(1);
+    ActionId otherReload = queue.enqueueReload(2);
+    check("ActionQueue/state updates use the reserve",
+          movement && weaponSwitch && reload && otherReload && queue.stats().depth == ActionQueue::CAPACITY);
+
+    // Full now: a new state update is dropped too, one already waiting still merges
+    ActionQueueStats full = queue.stats();
+    check("ActionQueue/full queue still merges",
+          queue.enqueueMovement((Vector3){ 1.0f, 0.0f, 0.0f }, 0.0f, (Vector3){ 0.0f, 0.0f, 0.0f }) == movement &&
+          queue.stats().dropped == full.dropped);
+    restart(queue);
+}
+
+// A transaction nobody answers fails after TIMEOUT_MS; its late answer is
+// ignored, and its slot isn't reused until that answer has arrived
+static void checkTimeout(ActionQueue& queue, Results& results) {
+    restart(queue);
+    queue.setMaxInFlight(ActionQueue::MAX_IN_FLIGHT);
+    double now = BridgeLatency::now();
+
+    results.count = 0;
+    ActionQueueStats before = queue.stats();
+    ActionId shot = queue.enqueueShoot(1);
+    queue.pump(now);
+    bool sent = queue.stats().inFlight == 1;
+    queue.pump(now + ActionQueue::TIMEOUT_MS - 1.0);
+    bool waiting = results.count == 0;
+    queue.pump(now + ActionQueue::TIMEOUT_MS);
+    ActionQueueStats after = queue.stats();
+    check("ActionQueue/unanswered transaction times out",
+          shot && sent && waiting && results.find(shot) == 1 && !results.success[0] &&
+          strcmp(results.errors[0], "Transaction timed out") == 0 &&
+          after.timedOut - before.timedOut == 1 && after.inFlight == 0);
+
+    deliverAnswers();
+    check("ActionQueue/late answer is ignored", results.count == 1 && queue.stats().inFlight == 0);
+
+    // Every slot owed an answer: nothing more goes out until one arrives
+    now += ActionQueue::TIMEOUT_MS;
+    for (int i = 0; i < ActionQueue::SLOTS; i++) {
+        queue.enqueueShoot(1);
+        queue.pump(now);
+        now += ActionQueue::TIMEOUT_MS;
+        queue.pump(now);
+    }
+    results.count = 0;
+    before = queue.stats();
+    ActionId held = queue.enqueueShoot(1);
+    queue.pump(now);
+    after = queue.stats();
+    check("ActionQueue/no slot reused while owed an answer",
+          held && after.sent == before.sent && after.depth == 1 && results.count == 0);
+
+    // The late answers free the slots and complete nothing
+    deliverAnswers();
+    bool lateIgnored = results.count == 0;
+    queue.pump(now);
+    bool heldSent = queue.stats().depth == 0 && queue.stats().inFlight == 1;
+    deliverAnswers();
+    check("ActionQueue/slot reused after its late answer",
+          lateIgnored && heldSent && results.count == 1 && results.find(held) == 1 && queue.stats().inFlight == 0);
+
+    queue.setMaxInFlight(ActionQueue::DEFAULT_MAX_IN_FLIGHT);
+    restart(queue);
+}
+
+int main() {
+    SetTraceLogLevel(LOG_WARNING);
+    MockChainConfig config = MockChainConfig::defaults();
+    config.latencyMs = 100.0;
+    config.jitterMs = 0.0;
+    config.botCount = 0;
+    MockChain::instance().configure(config);
+    NativeBridgeSetEnabled(true);
+
+    ActionQueue& queue = ActionQueue::instance();
+    Results results;
+    results.count = 0;
+    queue.addResultListener(onResult, &results);
+
+    checkMovementCoalescing(queue);
+    checkSwitchCoalescing(queue);
+    checkReloadMerging(queue);
+    checkStateReserve(queue);
+    checkTimeout(queue, results);
+
+    queue.removeResultListener(onResult, &results);
+    queue.setEnabled(false);
+    return failures == 0 ? 0 : 1;
+}
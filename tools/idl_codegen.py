@@ -0,0 +1,446 @@
+#!/usr/bin/env python3
+"""Generate C++ component types and zero-copy views from the Anchor IDLs.
+
+Usage: idl_codegen.py --out bolt_components.h idl/*.json
+
+Emits, in namespace bolt:
+  - program ids and instruction discriminators for every IDL
+  - the accounts each system instruction takes, in IDL order
+  - a plain struct per component type, with its account discriminator
+  - Borsh encoders (encode / encodeAccount)
+  - a read-only <Name>View over raw account bytes: bind() checks the
+    discriminator and bounds once, after which every accessor is a load at
+    a compile-time offset (or, past the first variable-size field, an
+    offset resolved during bind)
+
+The same component is described by several IDLs, and the copies drift (the
+system IDLs carry fields the component IDLs don't have yet). The layout
+with the most fields wins; every other copy must be a subsequence of it
+with matching types, otherwise generation fails.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+SCALARS = {
+    "u8": ("uint8_t", 1), "i8": ("int8_t", 1),
+    "u16": ("uint16_t", 2), "i16": ("int16_t", 2),
+    "u32": ("uint32_t", 4), "i32": ("int32_t", 4),
+    "u64": ("uint64_t", 8), "i64": ("int64_t", 8),
+    "f32": ("float", 4), "f64": ("double", 8),
+}
+
+# Types every Bolt IDL carries that aren't game components
+SKIPPED_TYPES = {"Entity"}
+
+
+def camel(name):
+    parts = name.split("_")
+    return parts[0] + "".join(p[:1].upper() + p[1:] for p in parts[1:])
+
+
+def upper(name):
+    return re.sub(r"(?<=[a-z0-9])(?=[A-Z])", "_", name).upper()
+
+
+def type_key(t):
+    return json.dumps(t, sort_keys=True)
+
+
+def fixed_size(t, types):
+    """Encoded size of a type, or None if it varies."""
+    if isinstance(t, str):
+        if t in SCALARS:
+            return SCALARS[t][1]
+        if t == "bool":
+            return 1
+        if t == "pubkey":
+            return 32
+        return None  # string, bytes
+    if "option" in t:
+        return None
+    if "defined" in t:
+        total = 0
+        for field in types[t["defined"]["name"]]:
+            size = fixed_size(field["type"], types)
+            if size is None:
+                return None
+            total += size
+        return total
+    raise ValueError("unsupported IDL type %r" % (t,))
+
+
+def cpp_type(t):
+    if isinstance(t, str):
+        if t in SCALARS:
+            return SCALARS[t][0]
+        return {"bool": "bool", "pubkey": "Pubkey", "string": "std::string"}[t]
+    if "option" in t:
+        return "std::optional<%s>" % cpp_type(t["option"])
+    if "defined" in t:
+        return t["defined"]["name"]
+    raise ValueError("unsupported IDL type %r" % (t,))
+
+
+def is_subsequence(short, long):
+    it = iter((f["name"], type_key(f["type"])) for f in long)
+    return all(any(item == candidate for candidate in it)
+               for item in ((f["name"], type_key(f["type"])) for f in short))
+
+
+def load_idls(paths):
+    idls = []
+    for path in sorted(paths):
+        with open(path) as f:
+            idl = json.load(f)
+        idl["_file"] = os.path.basename(path)
+        idls.append(idl)
+    return idls
+
+
+def merge_types(idls):
+    """Pick one layout per type name, checking the other copies agree."""
+    variants = {}
+    for idl in idls:
+        for t in idl.get("types", []):
+            if t["type"]["kind"] != "struct" or t["name"] in SKIPPED_TYPES:
+                continue
+            variants.setdefault(t["name"], []).append((idl["_file"], t["type"]["fields"]))
+
+    types, sources = {}, {}
+    for name, copies in variants.items():
+        best_file, best = max(copies, key=lambda c: len(c[1]))
+        for file, fields in copies:
+            if not is_subsequence(fields, best):
+                sys.exit("idl_codegen: %s in %s conflicts with %s" % (name, file, best_file))
+        types[name] = best
+        sources[name] = (best_file, sorted({f for f, fields in copies if len(fields) < len(best)}))
+    return types, sources
+
+
+def account_discriminators(idls):
+    found = {}
+    for idl in idls:
+        for account in idl.get("accounts", []):
+            previous = found.setdefault(account["name"], account["discriminator"])
+            if previous != account["discriminator"]:
+                sys.exit("idl_codegen: account %s has two discriminators" % account["name"])
+    return found
+
+
+def byte_list(values):
+    return ", ".join("%d" % v for v in values)
+
+
+def flatten(fields, types, prefix=""):
+    """Leaf fields of a component, nested structs expanded in place."""
+    leaves = []
+    for field in fields:
+        name = prefix + field["name"]
+        t = field["type"]
+        if isinstance(t, dict) and "defined" in t:
+            leaves += flatten(types[t["defined"]["name"]], types, name + "_")
+        else:
+            leaves.append((name, t))
+    return leaves
+
+
+def emit_header(out, idls):
+    out.append("// Generated by tools/idl_codegen.py from idl/*.json. Do not edit.")
+    out.append("#ifndef BOLT_COMPONENTS_H")
+    out.append("#define BOLT_COMPONENTS_H")
+    out.append("")
+    out.append("#include <stddef.h>")
+    out.append("#include <stdint.h>")
+    out.append("#include <string.h>")
+    out.append("#include <optional>")
+    out.append("#include <string>")
+    out.append("#include <string_view>")
+    out.append("#include \"borsh.h\"")
+    out.append("")
+    out.append("namespace bolt {")
+    out.append("")
+    out.append("using borsh::Pubkey;")
+    out.append("")
+    out.append("constexpr size_t DISCRIMINATOR_SIZE = 8;")
+    out.append("")
+
+
+def emit_programs(out, idls):
+    out.append("// Program ids")
+    out.append("namespace program {")
+    for idl in idls:
+        name = upper(idl["metadata"]["name"])
+        out.append("constexpr const char* %s = \"%s\";" % (name, idl["address"]))
+    out.append("} // namespace program")
+    out.append("")
+
+    # Component programs all share initialize/update; systems have one execute
+    out.append("// Instruction discriminators (first 8 bytes of instruction data)")
+    out.append("namespace instruction {")
+    shared = {}
+    for idl in idls:
+        program = upper(idl["metadata"]["name"])
+        for ins in idl.get("instructions", []):
+            if ins["name"] in ("initialize", "update"):
+                key = "COMPONENT_" + ins["name"].upper()
+                if shared.setdefault(key, ins["discriminator"]) != ins["discriminator"]:
+                    sys.exit("idl_codegen: %s differs across component programs" % key)
+                continue
+            out.append("constexpr uint8_t %s[DISCRIMINATOR_SIZE] = { %s }; // %s %s" % (
+                program, byte_list(ins["discriminator"]), idl["_file"], ins["name"]))
+    for key in sorted(shared):
+        out.append("constexpr uint8_t %s[DISCRIMINATOR_SIZE] = { %s };" % (key, byte_list(shared[key])))
+    out.append("} // namespace instruction")
+    out.append("")
+
+    out.append("// Accounts each system instruction takes, in order")
+    out.append("namespace accounts {")
+    out.append("struct Meta {")
+    out.append("    const char* name;")
+    out.append("    bool signer;")
+    out.append("};")
+    for idl in idls:
+        program = upper(idl["metadata"]["name"])
+        for ins in idl.get("instructions", []):
+            if ins["name"] in ("initialize", "update") or not ins["accounts"]:
+                continue
+            metas = ", ".join("{ \"%s\", %s }" % (a["name"], "true" if a.get("signer") else "false")
+                              for a in ins["accounts"])
+            out.append("constexpr Meta %s[] = { %s };" % (program, metas))
+    out.append("} // namespace accounts")
+    out.append("")
+
+
+def emit_struct(out, name, fields, discriminator, source):
+    file, older = source
+    note = "// Layout from %s" % file
+    if older:
+        note += "; older copies in %s" % ", ".join(older)
+    out.append(note)
+    out.append("struct %s {" % name)
+    if discriminator:
+        out.append("    static constexpr uint8_t DISCRIMINATOR[DISCRIMINATOR_SIZE] = { %s };" % byte_list(discriminator))
+        out.append("")
+    for field in fields:
+        out.append("    %s %s;" % (cpp_type(field["type"]), camel(field["name"])))
+    out.append("};")
+    out.append("")
+
+
+def encode_statement(t, expr):
+    if isinstance(t, str):
+        if t in SCALARS:
+            return "writer.write<%s>(%s);" % (SCALARS[t][0], expr)
+        return {"bool": "writer.writeBool(%s);", "pubkey": "writer.writePubkey(%s);",
+                "string": "writer.writeString(%s);"}[t] % expr
+    if "option" in t:
+        return "writer.writeOption(%s);" % expr
+    return "encode(writer, %s);" % expr
+
+
+def emit_encoder(out, name, fields, discriminator):
+    out.append("inline void encode(borsh::Writer& writer, const %s& value) {" % name)
+    for field in fields:
+        out.append("    " + encode_statement(field["type"], "value." + camel(field["name"])))
+    out.append("}")
+    out.append("")
+    if discriminator:
+        out.append("// Account data as stored on chain: discriminator, then the fields")
+        out.append("inline void encodeAccount(borsh::Writer& writer, const %s& value) {" % name)
+        out.append("    writer.writeBytes(%s::DISCRIMINATOR, DISCRIMINATOR_SIZE);" % name)
+        out.append("    encode(writer, value);")
+        out.append("}")
+        out.append("")
+
+
+def accessor(t, offset):
+    """Return type and body for a leaf accessor reading at `offset`."""
+    if isinstance(t, str):
+        if t in SCALARS:
+            c = SCALARS[t][0]
+            return c, "return borsh::load<%s>(data + %s);" % (c, offset)
+        if t == "bool":
+            return "bool", "return data[%s] != 0;" % offset
+        if t == "pubkey":
+            return "const uint8_t*", "return data + %s;" % offset
+        if t == "string":
+            return ("std::string_view",
+                    "return std::string_view((const char*)data + %s + 4, borsh::load<uint32_t>(data + %s));"
+                    % (offset, offset))
+    if "option" in t:
+        inner = t["option"]
+        if inner == "pubkey":
+            return "const uint8_t*", "return data[%s] ? data + %s + 1 : nullptr;" % (offset, offset)
+        c = cpp_type(inner)
+        if inner == "bool":
+            load = "data[%s + 1] != 0" % offset
+        else:
+            load = "borsh::load<%s>(data + %s + 1)" % (c, offset)
+        return "std::optional<%s>" % c, \
+            "return data[%s] ? std::optional<%s>(%s) : std::nullopt;" % (offset, c, load)
+    raise ValueError("unsupported leaf type %r" % (t,))
+
+
+def decode_expr(t, getter):
+    if isinstance(t, str):
+        if t == "pubkey":
+            return "toPubkey(%s())" % getter
+        if t == "string":
+            return "std::string(%s())" % getter
+        return "%s()" % getter
+    if "option" in t:
+        if t["option"] == "pubkey":
+            return "%s() ? std::optional<Pubkey>(toPubkey(%s())) : std::nullopt" % (getter, getter)
+        return "%s()" % getter
+    raise ValueError("unsupported leaf type %r" % (t,))
+
+
+def emit_view(out, name, fields, types, discriminator):
+    leaves = flatten(fields, types)
+    view = name + "View"
+
+    # Offsets are constant up to the first variable-size leaf
+    offsets = []
+    cursor = 8 if discriminator else 0
+    static = True
+    dynamic_index = 0
+    min_size = cursor
+    for leaf_name, t in leaves:
+        size = fixed_size(t, types)
+        if static:
+            offsets.append(("static", cursor))
+        else:
+            offsets.append(("dynamic", dynamic_index))
+            dynamic_index += 1
+        if size is None:
+            static = False
+            min_size += 4 if t == "string" else 1
+        else:
+            cursor += size
+            min_size += size
+    fully_fixed = static
+
+    out.append("// Read-only view over %s account bytes. bind() validates once; accessors" % name)
+    out.append("// then read in place with no copies or allocation.")
+    out.append("class %s {" % view)
+    out.append("public:")
+    for (leaf_name, t), (kind, value) in zip(leaves, offsets):
+        if kind == "static":
+            out.append("    static constexpr size_t %s_OFFSET = %d;" % (upper(leaf_name), value))
+    if fully_fixed:
+        out.append("    static constexpr size_t SIZE = %d;" % cursor)
+    out.append("    static constexpr size_t MIN_SIZE = %d;" % min_size)
+    out.append("")
+    out.append("    static bool bind(const uint8_t* data, size_t size, %s& view) {" % view)
+    out.append("        if (!data || size < MIN_SIZE) return false;")
+    if discriminator:
+        out.append("        if (memcmp(data, %s::DISCRIMINATOR, DISCRIMINATOR_SIZE) != 0) return false;" % name)
+    if not fully_fixed:
+        first_dynamic = next(i for i, (k, v) in enumerate(offsets) if k == "dynamic") - 1
+        out.append("        size_t cursor = %s_OFFSET;" % upper(leaves[first_dynamic][0]))
+        for i in range(first_dynamic, len(leaves)):
+            leaf_name, t = leaves[i]
+            kind, value = offsets[i]
+            if kind == "dynamic":
+                out.append("        view.offsets[%d] = cursor;" % value)
+            size = fixed_size(t, types)
+            if t == "string":
+                out.append("        if (cursor > size || size - cursor < 4) return false;")
+                out.append("        if (borsh::load<uint32_t>(data + cursor) > size - cursor - 4) return false;")
+                out.append("        cursor += 4 + borsh::load<uint32_t>(data + cursor); // %s" % leaf_name)
+            elif isinstance(t, dict) and "option" in t:
+                inner = fixed_size(t["option"], types)
+                if inner is None:
+                    sys.exit("idl_codegen: %s.%s: options of variable-size types aren't supported" % (name, leaf_name))
+                out.append("        if (cursor >= size || data[cursor] > 1) return false;")
+                out.append("        cursor += data[cursor] ? %d : 1; // %s" % (1 + inner, leaf_name))
+            else:
+                out.append("        cursor += %d; // %s" % (size, leaf_name))
+        out.append("        if (cursor > size) return false;")
+    out.append("        view.data = data;")
+    out.append("        view.size = size;")
+    out.append("        return true;")
+    out.append("    }")
+    out.append("")
+
+    for (leaf_name, t), (kind, value) in zip(leaves, offsets):
+        offset = "%s_OFFSET" % upper(leaf_name) if kind == "static" else "offsets[%d]" % value
+        ret, body = accessor(t, offset)
+        out.append("    %s %s() const { %s }" % (ret, camel(leaf_name), body))
+    out.append("")
+    out.append("    const uint8_t* bytes() const { return data; }")
+    out.append("    size_t byteSize() const { return size; }")
+    out.append("")
+    out.append("    // Owning copy, for code that keeps the state past the buffer's lifetime")
+    out.append("    %s decode() const {" % name)
+    out.append("        %s value;" % name)
+    for field in fields:
+        t = field["type"]
+        if isinstance(t, dict) and "defined" in t:
+            for sub_name, sub_t in flatten(types[t["defined"]["name"]], types, field["name"] + "_"):
+                member = "value.%s.%s" % (camel(field["name"]), camel(sub_name[len(field["name"]) + 1:]))
+                out.append("        %s = %s;" % (member, decode_expr(sub_t, camel(sub_name))))
+        else:
+            out.append("        value.%s = %s;" % (camel(field["name"]), decode_expr(t, camel(field["name"]))))
+    out.append("        return value;")
+    out.append("    }")
+    out.append("")
+    out.append("private:")
+    out.append("    const uint8_t* data = nullptr;")
+    out.append("    size_t size = 0;")
+    if dynamic_index:
+        out.append("    size_t offsets[%d] = {};" % dynamic_index)
+    out.append("};")
+    out.append("")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--out", required=True)
+    parser.add_argument("idl", nargs="+")
+    args = parser.parse_args()
+
+    idls = load_idls(args.idl)
+    types, sources = merge_types(idls)
+    discriminators = account_discriminators(idls)
+
+    out = []
+    emit_header(out, idls)
+    emit_programs(out, idls)
+    out.append("inline Pubkey toPubkey(const uint8_t* bytes) {")
+    out.append("    Pubkey key;")
+    out.append("    memcpy(key.data(), bytes, key.size());")
+    out.append("    return key;")
+    out.append("}")
+    out.append("")
+
+    # Helper structs (no discriminator) first, so components can embed them
+    order = sorted(types, key=lambda n: (n in discriminators, n))
+    for name in order:
+        emit_struct(out, name, types[name], discriminators.get(name), sources[name])
+        emit_encoder(out, name, types[name], discriminators.get(name))
+    for name in order:
+        if name in discriminators:
+            emit_view(out, name, types[name], types, discriminators[name])
+
+    out.append("} // namespace bolt")
+    out.append("")
+    out.append("#endif // BOLT_COMPONENTS_H")
+
+    text = "\n".join(out) + "\n"
+    os.makedirs(os.path.dirname(os.path.abspath(args.out)), exist_ok=True)
+    # Leave the file alone when nothing changed, so dependents don't rebuild
+    if os.path.exists(args.out):
+        with open(args.out) as f:
+            if f.read() == text:
+                return
+    with open(args.out, "w") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Pack the assets directory into indexed pack files for AssetPack.
+
+Usage: pack_assets.py --root . --out build/assets.pak
+                      [--critical 'assets/gun/*' ...] assets
+
+Writes the main pack (--out) and, if any file is not critical, a stream
+pack next to it (<name>_stream.pak). The main pack holds the index of
+every entry, in both packs, and the payloads of the critical ones; the
+game needs it before play starts. The stream pack is payloads only and may
+arrive later (on the web it is fetched after startup).
+
+Entries:
+  - PCM WAVs are stored as raw samples with their format, so loading them
+    is a copy (or an inflate) rather than a decode
+  - anything else (MP3, ...) is stored as the original file and decoded by
+    raylib from memory
+  - a payload is deflated when that saves at least COMPRESS_MIN_SAVING
+
+Layout, little endian; must match include/asset_pack.h:
+  header   "SPAK", u32 version, u32 entryCount, u32 packCount
+  packs    packCount x char[32] file names, 0 = the main pack
+  entries  entryCount x 128 bytes, sorted by name
+  payloads 16-byte aligned
+"""
+
+import argparse
+import fnmatch
+import os
+import struct
+import sys
+import wave
+import zlib
+
+MAGIC = b"SPAK"
+VERSION = 1
+NAME_SIZE = 96
+PACK_NAME_SIZE = 32
+ALIGNMENT = 16
+COMPRESS_MIN_SAVING = 0.10
+
+FORMAT_FILE = 0
+FORMAT_PCM = 1
+COMPRESSION_STORED = 0
+COMPRESSION_DEFLATE = 1
+
+HEADER = struct.Struct("<4sIII")
+ENTRY = struct.Struct("<%dsBBBBIIIIHHII" % NAME_SIZE)
+assert ENTRY.size == 128
+
+
+def read_pcm(path):
+    """(samples, rate, bits, channels, frames) for integer PCM WAVs, else None."""
+    try:
+        with wave.open(path, "rb") as w:
+            frames = w.getnframes()
+            samples = w.readframes(frames)
+            return samples, w.getframerate(), w.getsampwidth() * 8, w.getnchannels(), frames
+    except (wave.Error, EOFError):
+        return None  # Float or compressed WAV: ship the file as is
+
+
+def deflate(data):
+    # Raw deflate stream, no zlib header: what raylib's sinflate reads
+    packer = zlib.compressobj(9, zlib.DEFLATED, -15)
+    return packer.compress(data) + packer.flush()
+
+
+def collect(root, directories):
+    files = []
+    for directory in directories:
+        for base, dirs, names in os.walk(os.path.join(root, directory)):
+            dirs[:] = sorted(d for d in dirs if not d.startswith("."))
+            for name in sorted(names):
+                if name.startswith("."):
+                    continue  # .DS_Store and friends
+                path = os.path.join(base, name)
+                files.append((os.path.relpath(path, root).replace(os.sep, "/"), path))
+    return sorted(files)
+
+
+def build_entry(name, path):
+    pcm = read_pcm(path) if name.lower().endswith(".wav") else None
+    if pcm:
+        data, rate, bits, channels, frames = pcm
+        kind = FORMAT_PCM
+    else:
+        with open(path, "rb") as f:
+            data = f.read()
+        rate = bits = channels = frames = 0
+        kind = FORMAT_FILE
+
+    stored, compression = data, COMPRESSION_STORED
+    packed = deflate(data)
+    if len(packed) <= len(data) * (1.0 - COMPRESS_MIN_SAVING):
+        stored, compression = packed, COMPRESSION_DEFLATE
+    return {
+        "name": name, "format": kind, "compression": compression, "payload": stored,
+        "size": len(data), "rate": rate, "bits": bits, "channels": channels, "frames": frames,
+    }
+
+
+def layout(entries, start):
+    """Assigns offsets from `start`; returns the payload bytes."""
+    blob = bytearray()
+    for entry in entries:
+        padding = -(start + len(blob)) % ALIGNMENT
+        blob += b"\0" * padding
+        entry["offset"] = start + len(blob)
+        blob += entry["payload"]
+    return bytes(blob)
+
+
+def write_if_changed(path, data):
+    # Keep the bytes when nothing changed, but still touch the file: the build
+    # compares its time against the inputs and would rerun the pack every build
+    if os.path.exists(path):
+        with open(path, "rb") as f:
+            if f.read() == data:
+                os.utime(path, None)
+                return
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--root", default=".")
+    parser.add_argument("--out", required=True)
+    parser.add_argument("--critical", action="append", default=[],
+                        help="glob of entry names that go in the main pack")
+    parser.add_argument("directories", nargs="+")
+    args = parser.parse_args()
+
+    entries = []
+    for name, path in collect(args.root, args.directories):
+        if len(name.encode()) >= NAME_SIZE:
+            sys.exit("pack_assets: name too long: %s" % name)
+        entry = build_entry(name, path)
+        critical = any(fnmatch.fnmatch(name, pattern) for pattern in args.critical)
+        entry["pack"] = 0 if critical else 1
+        entries.append(entry)
+
+    main_name = os.path.basename(args.out)
+    stream_name = os.path.splitext(main_name)[0] + "_stream.pak"
+    packs = [main_name]
+    if any(e["pack"] == 1 for e in entries):
+        packs.append(stream_name)
+    for name in packs:
+        if len(name.encode()) >= PACK_NAME_SIZE:
+            sys.exit("pack_assets: pack name too long: %s" % name)
+
+    index_size = HEADER.size + PACK_NAME_SIZE * len(packs) + ENTRY.size * len(entries)
+    payloads = [layout([e for e in entries if e["pack"] == p], index_size if p == 0 else 0)
+                for p in range(len(packs))]
+
+    out = bytearray(HEADER.pack(MAGIC, VERSION, len(entries), len(packs)))
+    for name in packs:
+        out += struct.pack("<%ds" % PACK_NAME_SIZE, name.encode())
+    for e in entries:
+        out += ENTRY.pack(e["name"].encode(), e["pack"], e["format"], e["compression"], 0,
+                          e["offset"], len(e["payload"]), e["size"],
+                          e["rate"], e["bits"], e["channels"], e["frames"], 0)
+    out += payloads[0]
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.out)), exist_ok=True)
+    write_if_changed(args.out, bytes(out))
+    stream_path = os.path.join(os.path.dirname(os.path.abspath(args.out)), stream_name)
+    if len(packs) > 1:
+        write_if_changed(stream_path, payloads[1])
+    elif os.path.exists(stream_path):
+        os.remove(stream_path)
+
+
+if __name__ == "__main__":
+    main()